@@ -0,0 +1,55 @@
+#include "anim.h"
+#include "neopixel.h"
+
+static uint32_t animFrameUs(const anim_sequence_t *seq, uint32_t frame) {
+    if (seq->generate) {
+        uint16_t ms;
+        seq->generate(frame, &ms);
+        return ms * 1000u;
+    }
+    return (seq->frame_ms ? seq->frame_ms[frame] : seq->default_ms) * 1000u;
+}
+
+// Desenha o quadro 0 no back buffer e começa a contar a sua duração.
+// loops só vale para ANIM_LOOP: número de voltas, 0 para tocar sem fim.
+void animStart(anim_player_t *player, const anim_sequence_t *seq, uint16_t loops, uint64_t now) {
+    player->seq = seq;
+    player->next_delta = seq->delta;
+    player->frame = 0;
+    player->loops_left = loops;
+    player->deadline = now + animFrameUs(seq, 0);
+    npSetFrame(seq->key);
+}
+
+// Aplica os quadros cujo prazo venceu. Se o tick atrasou mais de um quadro,
+// os deltas atrasados são todos aplicados e só o último é apresentado.
+// Retorna false quando a animação termina; changed indica se o back buffer mudou.
+bool animUpdate(anim_player_t *player, uint64_t now, bool *changed) {
+    const anim_sequence_t *seq = player->seq;
+    *changed = false;
+
+    while (now >= player->deadline) {
+        if (player->frame + 1 < seq->frame_count) {
+            player->frame++;
+        } else if (seq->mode == ANIM_LOOP && player->loops_left != 1) {
+            if (player->loops_left)
+                player->loops_left--;
+            player->frame = 0;
+        } else {
+            return false;
+        }
+
+        if (seq->generate) {
+            uint16_t ms;
+            npApplyDelta(seq->generate(player->frame, &ms));
+            player->deadline += ms * 1000u;
+        } else {
+            player->next_delta = npApplyDelta(player->next_delta);
+            if (player->frame == 0)
+                player->next_delta = seq->delta;
+            player->deadline += animFrameUs(seq, player->frame);
+        }
+        *changed = true;
+    }
+    return true;
+}
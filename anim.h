@@ -0,0 +1,41 @@
+#pragma once
+
+#include "hal.h"
+
+// Animações como dados: um quadro inicial completo e quadros delta no
+// formato de peskel_convert -d, normalmente const (na flash, lidos por XIP).
+// Os quadros são aplicados direto da flash no back buffer, só os trechos
+// que mudam; o quadro 0 é comparado com o buffer atual e também só escreve
+// o que difere. A volta ao quadro 0 (ANIM_LOOP) é o delta N-1 -> 0, do
+// tamanho do que de fato muda. Os quadros são trocados por prazo: o
+// próximo prazo parte do anterior, não do instante em que o tick rodou,
+// então a cadência não acumula atraso.
+typedef enum {
+    ANIM_ONE_SHOT,  // Toca uma vez e termina no fim do último quadro
+    ANIM_LOOP       // Volta ao quadro 0 pelo delta de retorno
+} anim_mode_t;
+
+// Quadros calculados na hora (ex.: a sequência do jogo, que não é
+// guardada): retorna o delta que leva ao quadro frame e a sua duração
+typedef const uint32_t *(*anim_generate_t)(uint32_t frame, uint16_t *ms);
+
+typedef struct {
+    const uint32_t *key;        // Quadro 0 completo (LED_COUNT palavras GRB)
+    const uint32_t *delta;      // Quadros 1..N-1 e o retorno ao quadro 0
+    const uint16_t *frame_ms;   // Duração de cada quadro, ou NULL
+    uint16_t default_ms;        // Duração dos quadros quando frame_ms é NULL
+    anim_generate_t generate;   // Se definido, substitui delta e frame_ms
+    uint32_t frame_count;
+    anim_mode_t mode;
+} anim_sequence_t;
+
+typedef struct {
+    const anim_sequence_t *seq;
+    const uint32_t *next_delta; // Próximo quadro delta a aplicar
+    uint32_t frame;             // Quadro no back buffer
+    uint16_t loops_left;        // ANIM_LOOP: voltas restantes (0 = sem fim)
+    uint64_t deadline;          // Fim do quadro atual
+} anim_player_t;
+
+void animStart(anim_player_t *player, const anim_sequence_t *seq, uint16_t loops, uint64_t now);
+bool animUpdate(anim_player_t *player, uint64_t now, bool *changed);
@@ -0,0 +1,22 @@
+#include "animations.h"
+#include "game.h"
+#include "render.h"
+#include "simon_assets.h"
+
+// Vermelho e apagado, FLASH_MS cada; o jogo escolhe o número de piscadas
+const anim_sequence_t anim_error = {
+    .key = erro_key,
+    .delta = erro_delta,
+    .default_ms = FLASH_MS,
+    .frame_count = ERRO_FRAME_COUNT,
+    .mode = ANIM_LOOP,
+};
+
+// Fica na tela durante a pausa entre as rodadas
+const anim_sequence_t anim_success = {
+    .key = acerto_key,
+    .delta = acerto_delta,
+    .default_ms = ROUND_PAUSE_MS,
+    .frame_count = ACERTO_FRAME_COUNT,
+    .mode = ANIM_ONE_SHOT,
+};
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "anim.h"
+
+// Animações fixas do jogo, geradas de assets/ por peskel_convert
+extern const anim_sequence_t anim_error;    // Matriz vermelha piscando (ANIM_LOOP)
+extern const anim_sequence_t anim_success;  // Sinal de acerto ao completar a rodada
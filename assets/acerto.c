@@ -0,0 +1,13 @@
+#include <stdint.h>
+
+#define ACERTO_FRAME_COUNT 1
+#define ACERTO_FRAME_WIDTH 5
+#define ACERTO_FRAME_HEIGHT 5
+
+/* Piskel data for "acerto" */
+
+static const uint32_t acerto_data[1][25] = {
+{
+0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff00ff00, 0x00000000, 0x00000000, 0x00000000, 0xff00ff00, 0x00000000, 0xff00ff00, 0x00000000, 0xff00ff00, 0x00000000, 0x00000000, 0x00000000, 0xff00ff00, 0x00000000, 0x00000000, 0x00000000
+}
+};
@@ -0,0 +1,41 @@
+// Gerado por peskel_convert. Não edite: altere as animações e recompile.
+// Brilho 40, gamma 2.20, ordem GRB, matriz 5x5 em 1 fita(s), quadros delta
+#pragma once
+
+#include <stdint.h>
+
+#include "panel.h"
+
+#if NP_PANEL_COLS != 5 || NP_PANEL_ROWS != 5 || NP_PANELS_X != 1 || NP_PANELS_Y != 1
+#error "Animações convertidas para outra geometria da matriz"
+#endif
+
+// erro.c
+#define ERRO_FRAME_COUNT 2
+static const uint32_t erro_key[25] = {
+    0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000,
+    0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000,
+    0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000,
+    0x00280000,
+};
+static const uint32_t erro_delta[54] = {
+    0x00000019, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000019, 0x00280000, 0x00280000, 0x00280000, 0x00280000,
+    0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000,
+    0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000,
+    0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00280000, 0x00000000,
+};
+
+// acerto.c
+#define ACERTO_FRAME_COUNT 1
+static const uint32_t acerto_key[25] = {
+    0x00000000, 0x00000000, 0x00000000, 0x28000000, 0x00000000, 0x28000000, 0x00000000, 0x28000000,
+    0x00000000, 0x00000000, 0x00000000, 0x28000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x28000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+    0x00000000,
+};
+static const uint32_t acerto_delta[1] = {
+    0x00000000,
+};
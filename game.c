@@ -0,0 +1,183 @@
+#include "animations.h"
+#include "game.h"
+#include "joystick.h"
+#include "neopixel.h"
+#include "perf.h"
+#include "render.h"
+#include "scores.h"
+
+uint32_t game_seed = 0;
+static uint32_t game_next_seed = 0; // Semente pedida por gameReplay
+static bool game_replay = false;    // A próxima partida usa game_next_seed
+int player_index = 0;
+int sequence_length = 1;
+
+int led_x = 1, led_y = 1;
+
+// Estados do jogo. Cada estado avança por prazos em hal_time_us() ou pelo
+// fim de uma animação do renderizador, nunca por sleep.
+typedef enum {
+    GAME_RESET,         // Escolhe a semente da nova partida
+    GAME_SHOW_SEQUENCE, // Renderizador exibe a sequência ao jogador
+    GAME_AWAIT_INPUT,   // Jogador move o cursor e confirma com o botão
+    GAME_SUCCESS,       // LED escolhido aceso em verde
+    GAME_FAILURE        // Matriz pisca em vermelho, depois pausa
+} game_state_t;
+
+static game_state_t game_state = GAME_RESET;
+static uint64_t state_deadline = 0; // Próximo prazo do estado atual
+static int state_step = 0;          // Sub-passo dentro do estado
+static uint32_t state_wait_id = 0;  // Animação que o estado espera terminar
+
+static uint64_t cursor_deadline = 0;
+
+// Entra em um estado com o primeiro prazo delay_ms a partir de now
+static void enterState(game_state_t state, uint64_t now, uint32_t delay_ms) {
+    game_state = state;
+    state_step = 0;
+    state_deadline = now + delay_ms * 1000ull;
+}
+
+// Verdadeiro quando a animação esperada pelo estado atual terminou
+static bool animationDone() {
+    return renderDoneId() == state_wait_id;
+}
+
+// Começa a exibição da sequência atual
+static void showSequence(uint64_t now) {
+    enterState(GAME_SHOW_SEQUENCE, now, 0);
+    state_wait_id = renderSend(&(render_cmd_t){.type = RENDER_PLAY_SEQUENCE, .seed = game_seed, .count = sequence_length});
+}
+
+// A próxima partida usa a semente seed, repetindo a sequência de um jogo
+// registrado
+void gameReplay(uint32_t seed) {
+    game_next_seed = seed;
+    game_replay = true;
+}
+
+// Reinicia o jogo com uma nova semente, misturando a anterior com o relógio
+void resetGame(uint64_t now) {
+    sequence_length = 1;
+    player_index = 0;
+
+    game_seed = game_replay ? game_next_seed : gameHash(game_seed ^ (uint32_t)now ^ (uint32_t)(now >> 32));
+    game_replay = false;
+
+    showSequence(now);
+}
+
+// Passa a vez ao jogador e desenha o cursor
+static void awaitInput(uint64_t now) {
+    enterState(GAME_AWAIT_INPUT, now, 0);
+    renderSend(&(render_cmd_t){.type = RENDER_CURSOR, .index = getLedIndex(led_x, led_y)});
+}
+
+// Atualiza a posição do LED com o joystick, repetindo o passo a cada
+// CURSOR_REPEAT_MS enquanto o joystick estiver inclinado
+void updateLedPosition(uint64_t now) {
+    uint16_t eixo_x, eixo_y;
+    joystick_read_axis(&eixo_x, &eixo_y);
+    int dir_x = joystickAxisDir(ADC_CHANNEL_1, eixo_x);
+    int dir_y = joystickAxisDir(ADC_CHANNEL_0, eixo_y);
+
+    if (dir_x == 0 && dir_y == 0) {
+        cursor_deadline = now; // Resposta imediata na próxima inclinação
+        return;
+    }
+    if (now < cursor_deadline)
+        return;
+    cursor_deadline = now + CURSOR_REPEAT_MS * 1000ull;
+
+    int max_x = NP_COLS - 1, max_y = NP_ROWS - 1; // Dimensões da matriz
+    int old_x = led_x, old_y = led_y;
+
+    if (dir_x > 0 && led_x > 0){
+        led_x--;
+    } 
+    if (dir_x < 0 && led_x < max_x){
+        led_x++;
+    }
+    if (dir_y > 0 && led_y < max_y){
+        led_y++;
+    }
+    if (dir_y < 0 && led_y > 0){ 
+        led_y--;
+    }
+
+    if (led_x != old_x || led_y != old_y)
+        renderSend(&(render_cmd_t){.type = RENDER_CURSOR, .index = getLedIndex(led_x, led_y)});
+}
+
+// Compara o LED escolhido com o próximo passo da sequência. press_us é o
+// instante da borda do botão, usado para medir a latência até os LEDs.
+void checkJoystickClick(uint64_t now, uint64_t press_us) {
+    int current_led_index = getLedIndex(led_x, led_y);
+
+    if (player_index < sequence_length && current_led_index == sequenceStep(game_seed, player_index)) {
+        player_index++;
+        enterState(GAME_SUCCESS, now, SUCCESS_MS);
+        renderSend(&(render_cmd_t){.type = RENDER_LED, .index = current_led_index, .color = 0x00FF00, .input_us = press_us}); // LED verde
+    } else {
+        enterState(GAME_FAILURE, now, 0);
+        state_wait_id = renderSend(&(render_cmd_t){.type = RENDER_ANIMATION, .anim = &anim_error, .count = FLASH_TIMES, .input_us = press_us});
+    }
+}
+
+// Avança o estado atual quando o seu prazo vence
+void gameUpdate(uint64_t now) {
+    // A fila é esvaziada em todos os estados, mas os cliques só contam
+    // durante a vez do jogador; o cursor se move se ainda for a vez dele
+    uint32_t start = perfStart();
+    button_event_t event;
+    while (buttonPop(&event)) {
+        if (event.type == BUTTON_PRESS && game_state == GAME_AWAIT_INPUT)
+            checkJoystickClick(now, event.time_us);
+    }
+    if (game_state == GAME_AWAIT_INPUT)
+        updateLedPosition(now);
+    perfEnd(PERF_INPUT, start);
+
+    switch (game_state) {
+    case GAME_RESET:
+        resetGame(now);
+        break;
+    case GAME_SHOW_SEQUENCE:
+        if (animationDone())
+            awaitInput(now);
+        break;
+    case GAME_AWAIT_INPUT:
+        break;
+    case GAME_SUCCESS:
+        if (now < state_deadline)
+            break;
+        if (player_index < sequence_length) {
+            awaitInput(now);
+        } else if (state_step == 0) {
+            state_step = 1; // Rodada completa: sinal de acerto antes da próxima
+            state_wait_id = renderSend(&(render_cmd_t){.type = RENDER_ANIMATION, .anim = &anim_success});
+        } else if (animationDone()) {
+            sequence_length++;
+            player_index = 0;
+            showSequence(now);
+        }
+        break;
+    case GAME_FAILURE:
+        // Espera as piscadas e então a pausa final, durante a qual a
+        // partida é registrada na flash. A gravação trava o tick (e, com
+        // dois cores, o core 1) de propósito aqui: a matriz está parada e a
+        // entrada é ignorada. Gravar uma página leva cerca de 1 ms; a cada
+        // SCORES_PER_SECTOR partidas um setor também é apagado, dezenas de ms.
+        if (state_step == 0) {
+            if (animationDone()) {
+                state_step = 1;
+                state_deadline = now + FAILURE_PAUSE_MS * 1000ull;
+                if (sequence_length > 1)
+                    scoresAppend(game_seed, sequence_length - 1);
+            }
+        } else if (now >= state_deadline) {
+            enterState(GAME_RESET, now, 0);
+        }
+        break;
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "hal.h"
+#include "panel.h"
+
+#define GAME_TICK_US 5000       // Período do tick (entrada + renderização)
+#define SUCCESS_MS 300          // Feedback de acerto
+#define ROUND_PAUSE_MS 500      // Sinal de acerto depois de completar a rodada
+#define FLASH_TIMES 3           // Número de piscadas no erro
+#define FAILURE_PAUSE_MS 1000   // Pausa depois das piscadas
+#define CURSOR_REPEAT_MS 100    // Repetição do cursor com o joystick inclinado
+
+// Sequência do jogo. Ela não é guardada: o passo n é recalculado a partir
+// da semente da partida, então o jogo não tem limite de rodadas.
+extern uint32_t game_seed;
+extern int player_index;
+extern int sequence_length;
+
+// Posição do cursor na matriz
+extern int led_x, led_y;
+
+// Embaralhamento de 32 bits (lowbias32, de Chris Wellons)
+static inline uint32_t gameHash(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// LED do passo n da sequência da semente seed: gerador por contador, sem
+// estado, em O(1) para qualquer n. O índice sai dos 16 bits altos por
+// multiplicação, sem divisão.
+static inline int sequenceStep(uint32_t seed, uint32_t n) {
+    return ((gameHash(seed + n * 0x9E3779B9u) >> 16) * LED_COUNT) >> 16;
+}
+
+void gameReplay(uint32_t seed);
+void resetGame(uint64_t now);
+void updateLedPosition(uint64_t now);
+void checkJoystickClick(uint64_t now, uint64_t press_us);
+void gameUpdate(uint64_t now);
@@ -0,0 +1,74 @@
+#pragma once
+
+// Camada fina de hardware usada pela lógica do jogo, dos LEDs e do joystick.
+// No firmware ela é implementada por hal_pico.c sobre o Pico SDK; com
+// SIMON_HOST, por host/hal_sim.c, que simula o hardware em tempo virtual.
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef SIMON_HOST
+typedef unsigned int uint;
+#define hal_dmb() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define hal_sev() ((void)0)
+static inline void tight_loop_contents(void) {}
+#else
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#define hal_dmb() __dmb()
+#define hal_sev() __sev()
+#endif
+
+// Alarme de uso único: retorna 0 para terminar ou N > 0 para disparar de
+// novo N µs depois (mesma convenção de add_alarm_in_us)
+typedef int64_t (*hal_alarm_callback_t)(void);
+
+// Borda no pino do botão, com o instante em que foi vista
+typedef void (*hal_edge_callback_t)(uint64_t time_us);
+
+// Tempo monotônico em microssegundos
+uint64_t hal_time_us(void);
+
+// Agenda callback para daqui a us microssegundos (em interrupção)
+bool hal_alarm_in_us(uint64_t us, hal_alarm_callback_t callback);
+
+// Saída WS2812 em lanes fitas paralelas, uma por pino. A fita i recebe as
+// palavras GRB words[i * lane_leds ...]. hal_led_put inicia o envio de
+// counts[i] palavras em cada fita (0 = fita parada) sem bloquear e chama
+// npTransmitDone() quando todas terminam e o latch passa.
+void hal_led_init(const uint *pins, uint lanes, uint lane_leds);
+void hal_led_put(const uint32_t *words, const uint *counts);
+
+// Quando o DMA de uma fita termina, a FIFO e o OSR do PIO ainda guardam
+// HAL_LED_FIFO_WORDS pixels (9 de 24 bits a 800 kHz = 270 µs). O link fica
+// ocupado por HAL_LED_LATCH_US depois disso: esse esvaziamento mais o
+// reset/latch (≥ 280 µs no WS2812B).
+#define HAL_LED_FIFO_WORDS 9
+#define HAL_LED_LATCH_US 560
+
+// ADC em conversão contínua (round robin pelos canais de channel_mask),
+// escrevendo em ring[0..samples) circularmente. hal_adc_write_index
+// retorna a posição onde a próxima amostra será escrita.
+void hal_adc_start(uint16_t *ring, uint samples, uint channel_mask, uint sample_hz);
+uint32_t hal_adc_write_index(void);
+
+// Entrada digital com pull-up e interrupção nas duas bordas
+void hal_button_init(uint pin, hal_edge_callback_t callback);
+bool hal_gpio_get(uint pin);
+
+// Saída de texto (USB no firmware, stdout no host) que nunca bloqueia:
+// entrega até len bytes e retorna quantos foram aceitos; o resto deve ser
+// reenviado depois
+uint hal_log_write(const char *buf, uint len);
+
+// Área reservada no fim da flash, HAL_STORE_SECTORS setores de
+// HAL_STORE_SECTOR_SIZE bytes, lida direto da memória. Como em qualquer NOR,
+// apagar leva um setor a 0xFF e gravar só pode zerar bits; a gravação é
+// feita em páginas inteiras (bytes 0xFF mantêm o conteúdo).
+#define HAL_STORE_SECTORS 2
+#define HAL_STORE_SECTOR_SIZE 4096
+#define HAL_STORE_PAGE_SIZE 256
+
+const uint8_t *hal_store_data(void);
+void hal_store_erase(uint sector);
+void hal_store_program_page(uint offset, const uint8_t *page);
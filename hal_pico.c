@@ -0,0 +1,221 @@
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/gpio.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#if SIMON_DUAL_CORE
+#include "pico/multicore.h"
+#endif
+
+#include "hal.h"
+#include "neopixel.h"
+#include "ws2818b.pio.h"
+
+// Uma state machine e um canal DMA por fita: as lanes 0-3 usam o pio0 e as
+// 4-7 o pio1, todas com o mesmo programa
+#define NP_MAX_LANES 8
+
+static uint np_lanes;
+static uint np_lane_leds;
+static int np_dma_chans[NP_MAX_LANES];
+static uint32_t np_dma_mask;              // Canais DMA de todas as fitas
+static volatile uint32_t np_dma_pending;  // Canais ainda transmitindo
+
+static int adc_dma_chan;
+static uint16_t *adc_ring;
+static uint adc_ring_samples;
+static hal_edge_callback_t button_callback;
+
+uint64_t hal_time_us(void) {
+    return time_us_64();
+}
+
+static int64_t halAlarmTrampoline(alarm_id_t id, void *user_data) {
+    return ((hal_alarm_callback_t)user_data)();
+}
+
+bool hal_alarm_in_us(uint64_t us, hal_alarm_callback_t callback) {
+    return add_alarm_in_us(us, halAlarmTrampoline, (void *)callback, true) >= 0;
+}
+
+// Fim do período de latch: o link está livre para o próximo quadro
+static int64_t npLatchDone(alarm_id_t id, void *user_data) {
+    npTransmitDone();
+    return 0;
+}
+
+// Fim da transferência DMA de uma fita. Quando a última termina, os últimos
+// bytes ainda estão na FIFO do PIO, então o latch é contado por um alarme
+// em vez de sleep_us().
+static void npDmaHandler() {
+    uint32_t done = dma_hw->ints0 & np_dma_mask;
+    dma_hw->ints0 = done;
+    np_dma_pending &= ~done;
+    if (done && !np_dma_pending)
+        add_alarm_in_us(HAL_LED_LATCH_US, npLatchDone, NULL, true);
+}
+
+void hal_led_init(const uint *pins, uint lanes, uint lane_leds) {
+    np_lanes = lanes;
+    np_lane_leds = lane_leds;
+
+    PIO pios[2] = {pio0, pio1};
+    uint offsets[2];
+    for (uint i = 0; i < 2 && i * 4 < lanes; i++)
+        offsets[i] = pio_add_program(pios[i], &ws2818b_program);
+
+    for (uint lane = 0; lane < lanes; lane++) {
+        PIO pio = pios[lane / 4];
+        uint sm = pio_claim_unused_sm(pio, true);
+        ws2818b_packed_program_init(pio, sm, offsets[lane / 4], pins[lane], 800000.f);
+        pio_sm_set_enabled(pio, sm, true);
+
+        // Canal DMA de 32 bits ritmado pelo DREQ de TX da state machine: uma
+        // transferência por LED, direto do trecho da fita no framebuffer.
+        int chan = dma_claim_unused_channel(true);
+        dma_channel_config c = dma_channel_get_default_config(chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+        dma_channel_configure(chan, &c, &pio->txf[sm], NULL, lane_leds, false);
+        dma_channel_set_irq0_enabled(chan, true);
+        np_dma_chans[lane] = chan;
+        np_dma_mask |= 1u << chan;
+    }
+
+    irq_set_exclusive_handler(DMA_IRQ_0, npDmaHandler);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// Todas as fitas começam juntas, então o tempo de um quadro é o da fita
+// mais longa e não cresce com o número de fitas
+void hal_led_put(const uint32_t *words, const uint *counts) {
+    uint32_t start = 0;
+    for (uint lane = 0; lane < np_lanes; lane++) {
+        if (!counts[lane])
+            continue;
+        int chan = np_dma_chans[lane];
+        dma_channel_set_read_addr(chan, words + lane * np_lane_leds, false);
+        dma_channel_set_trans_count(chan, counts[lane], false);
+        start |= 1u << chan;
+    }
+    np_dma_pending = start;
+    dma_start_channel_mask(start);
+}
+
+// O DMA do ADC só termina depois de 2^32 amostras; rearma a contagem
+static void adcDmaHandler() {
+    dma_channel_acknowledge_irq1(adc_dma_chan);
+    dma_channel_set_trans_count(adc_dma_chan, 0xFFFFFFFFu, true);
+}
+
+// O ring precisa estar alinhado ao seu tamanho em bytes (potência de 2)
+void hal_adc_start(uint16_t *ring, uint samples, uint channel_mask, uint sample_hz) {
+    adc_ring = ring;
+    adc_ring_samples = samples;
+
+    adc_init();
+    uint first = 0;
+    for (uint ch = 4; ch-- > 0; ) {
+        if (channel_mask & (1u << ch)) {
+            adc_gpio_init(26 + ch);
+            first = ch;
+        }
+    }
+    adc_select_input(first);
+    adc_set_round_robin(channel_mask);
+    adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ, 12 bits
+    adc_set_clkdiv(48000000.f / sample_hz - 1);
+
+    // DMA de 16 bits da FIFO do ADC para o buffer circular (anel no destino)
+    adc_dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(adc_dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, __builtin_ctz(samples * sizeof(uint16_t)));
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(adc_dma_chan, &c, ring, &adc_hw->fifo, 0xFFFFFFFFu, true);
+
+    dma_channel_set_irq1_enabled(adc_dma_chan, true);
+    irq_set_exclusive_handler(DMA_IRQ_1, adcDmaHandler);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    adc_run(true);
+}
+
+uint32_t hal_adc_write_index(void) {
+    uint32_t write_addr = dma_channel_hw_addr(adc_dma_chan)->write_addr;
+    return (write_addr - (uint32_t)(uintptr_t)adc_ring) / sizeof(uint16_t) % adc_ring_samples;
+}
+
+static void buttonIrq(uint gpio, uint32_t events) {
+    button_callback(time_us_64());
+}
+
+void hal_button_init(uint pin, hal_edge_callback_t callback) {
+    button_callback = callback;
+    gpio_init(pin);
+    gpio_set_dir(pin, GPIO_IN);
+    gpio_pull_up(pin);
+    gpio_set_irq_enabled_with_callback(pin, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, buttonIrq);
+}
+
+bool hal_gpio_get(uint pin) {
+    return gpio_get(pin);
+}
+
+// Só escreve o que cabe agora no buffer de transmissão do CDC: com espaço,
+// o stdio_usb não espera. Sem terminal aberto a saída é descartada.
+uint hal_log_write(const char *buf, uint len) {
+    if (!tud_cdc_connected())
+        return len;
+    uint room = tud_cdc_write_available();
+    if (len > room)
+        len = room;
+    if (len)
+        stdio_usb.out_chars(buf, len);
+    return len;
+}
+
+// Área reservada nos últimos setores da flash, fora do programa
+#define HAL_STORE_OFFSET (PICO_FLASH_SIZE_BYTES - HAL_STORE_SECTORS * HAL_STORE_SECTOR_SIZE)
+
+const uint8_t *hal_store_data(void) {
+    return (const uint8_t *)(XIP_BASE + HAL_STORE_OFFSET);
+}
+
+// Enquanto a flash é apagada ou gravada ela sai do modo XIP: nada pode
+// executar da flash nem ler as animações dela. As interrupções ficam
+// desligadas e, com dois cores, o core 1 espera em RAM (multicore_lockout).
+static uint32_t storeBegin() {
+#if SIMON_DUAL_CORE
+    multicore_lockout_start_blocking();
+#endif
+    return save_and_disable_interrupts();
+}
+
+static void storeEnd(uint32_t irq) {
+    restore_interrupts(irq);
+#if SIMON_DUAL_CORE
+    multicore_lockout_end_blocking();
+#endif
+}
+
+void hal_store_erase(uint sector) {
+    uint32_t irq = storeBegin();
+    flash_range_erase(HAL_STORE_OFFSET + sector * HAL_STORE_SECTOR_SIZE, HAL_STORE_SECTOR_SIZE);
+    storeEnd(irq);
+}
+
+void hal_store_program_page(uint offset, const uint8_t *page) {
+    uint32_t irq = storeBegin();
+    flash_range_program(HAL_STORE_OFFSET + offset, page, HAL_STORE_PAGE_SIZE);
+    storeEnd(irq);
+}
@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hal_sim.h"
+#include "neopixel.h"
+
+// WS2812 a 800 kHz: 24 bits por LED
+#define SIM_PIXEL_US 30
+
+#define SIM_MAX_ALARMS 16
+
+typedef struct {
+    bool active;
+    uint64_t at;
+    hal_alarm_callback_t callback;
+} sim_alarm_t;
+
+static uint64_t sim_now = 0;
+static sim_alarm_t sim_alarms[SIM_MAX_ALARMS];
+
+static uint16_t *adc_ring;
+static uint adc_ring_samples;
+static uint adc_channel_mask;
+static uint adc_channel;
+static uint32_t adc_write_index;
+static uint64_t adc_period_us;
+static uint64_t adc_next_us = UINT64_MAX;
+static uint16_t adc_values[4] = {2048, 2048, 2048, 2048};
+
+static hal_edge_callback_t button_callback;
+static bool button_level = true; // Pull-up: solto = 1
+
+static sim_frame_callback_t frame_callback;
+static uint8_t store[HAL_STORE_SECTORS * HAL_STORE_SECTOR_SIZE];
+static bool store_ready = false;
+uint32_t sim_store_erases = 0;
+static uint led_lanes;
+static uint led_lane_leds;
+
+uint64_t hal_time_us(void) {
+    return sim_now;
+}
+
+bool hal_alarm_in_us(uint64_t us, hal_alarm_callback_t callback) {
+    for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+        if (!sim_alarms[i].active) {
+            sim_alarms[i] = (sim_alarm_t){true, sim_now + us, callback};
+            return true;
+        }
+    }
+    return false;
+}
+
+static int64_t simTransmitDone(void) {
+    npTransmitDone();
+    return 0;
+}
+
+void hal_led_init(const uint *pins, uint lanes, uint lane_leds) {
+    led_lanes = lanes;
+    led_lane_leds = lane_leds;
+}
+
+// As fitas transmitem em paralelo: o quadro dura o tempo da fita mais longa.
+// Como no firmware, o latch é contado a partir do fim do DMA, quando os
+// últimos HAL_LED_FIFO_WORDS pixels ainda estão na FIFO do PIO.
+void hal_led_put(const uint32_t *words, const uint *counts) {
+    uint longest = 0, end = 0;
+    for (uint lane = 0; lane < led_lanes; lane++) {
+        if (counts[lane] > longest)
+            longest = counts[lane];
+        if (counts[lane])
+            end = lane * led_lane_leds + counts[lane];
+    }
+    if (frame_callback)
+        frame_callback(sim_now, words, end);
+    uint dma_pixels = longest > HAL_LED_FIFO_WORDS ? longest - HAL_LED_FIFO_WORDS : 0;
+    if (!hal_alarm_in_us(dma_pixels * SIM_PIXEL_US + HAL_LED_LATCH_US, simTransmitDone)) {
+        fprintf(stderr, "hal_sim: sem alarmes livres\n");
+        exit(1);
+    }
+}
+
+// Próximo canal habilitado depois de channel, como no round robin do RP2040
+static uint nextAdcChannel(uint channel) {
+    do {
+        channel = (channel + 1) % 4;
+    } while (!(adc_channel_mask & (1u << channel)));
+    return channel;
+}
+
+void hal_adc_start(uint16_t *ring, uint samples, uint channel_mask, uint sample_hz) {
+    adc_ring = ring;
+    adc_ring_samples = samples;
+    adc_channel_mask = channel_mask;
+    adc_channel = nextAdcChannel(3); // Menor canal habilitado
+    adc_write_index = 0;
+    adc_period_us = 1000000 / sample_hz;
+    adc_next_us = sim_now + adc_period_us;
+}
+
+uint32_t hal_adc_write_index(void) {
+    return adc_write_index;
+}
+
+void hal_button_init(uint pin, hal_edge_callback_t callback) {
+    button_callback = callback;
+}
+
+bool hal_gpio_get(uint pin) {
+    return button_level;
+}
+
+uint hal_log_write(const char *buf, uint len) {
+    return fwrite(buf, 1, len, stdout);
+}
+
+// Flash simulada: começa apagada e a gravação só zera bits, como na NOR
+const uint8_t *hal_store_data(void) {
+    if (!store_ready) {
+        memset(store, 0xFF, sizeof(store));
+        store_ready = true;
+    }
+    return store;
+}
+
+void hal_store_erase(uint sector) {
+    hal_store_data();
+    memset(&store[sector * HAL_STORE_SECTOR_SIZE], 0xFF, HAL_STORE_SECTOR_SIZE);
+    sim_store_erases++;
+}
+
+void hal_store_program_page(uint offset, const uint8_t *page) {
+    hal_store_data();
+    for (uint i = 0; i < HAL_STORE_PAGE_SIZE; i++)
+        store[offset + i] &= page[i];
+}
+
+void sim_advance_to(uint64_t time_us) {
+    while (true) {
+        // Evento mais próximo: um alarme ou a próxima amostra do ADC
+        sim_alarm_t *next = NULL;
+        for (uint i = 0; i < SIM_MAX_ALARMS; i++) {
+            if (sim_alarms[i].active && (!next || sim_alarms[i].at < next->at))
+                next = &sim_alarms[i];
+        }
+        uint64_t at = next ? next->at : UINT64_MAX;
+        if (adc_next_us < at)
+            at = adc_next_us;
+        if (at > time_us)
+            break;
+        sim_now = at;
+
+        if (next && next->at == at) {
+            next->active = false;
+            int64_t again = next->callback();
+            if (again > 0)
+                hal_alarm_in_us(again, next->callback);
+        } else {
+            adc_ring[adc_write_index] = adc_values[adc_channel];
+            adc_write_index = (adc_write_index + 1) % adc_ring_samples;
+            adc_channel = nextAdcChannel(adc_channel);
+            adc_next_us += adc_period_us;
+        }
+    }
+    sim_now = time_us;
+}
+
+void sim_set_adc(uint channel, uint16_t value) {
+    adc_values[channel] = value;
+}
+
+void sim_set_button(bool pressed) {
+    if (button_level == !pressed)
+        return;
+    button_level = !pressed;
+    if (button_callback)
+        button_callback(sim_now);
+}
+
+void sim_on_frame(sim_frame_callback_t callback) {
+    frame_callback = callback;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// Controle do hardware simulado (host/hal_sim.c). O tempo é virtual: ele só
+// anda quando sim_advance_to é chamado, então a reprodução é determinística.
+
+#include "hal.h"
+
+typedef void (*sim_frame_callback_t)(uint64_t time_us, const uint32_t *words, uint count);
+
+// Avança o relógio até time_us, disparando alarmes e amostras do ADC
+void sim_advance_to(uint64_t time_us);
+
+// Valor cru (0..4095) de um canal do ADC
+void sim_set_adc(uint channel, uint16_t value);
+
+// Nível do botão (pressionado = pino em 0) e borda correspondente
+void sim_set_button(bool pressed);
+
+// Setores da flash simulada apagados até agora
+extern uint32_t sim_store_erases;
+
+// Chamado a cada quadro enviado aos LEDs, com o framebuffer até o último
+// pixel enviado pela última fita que transmitiu
+void sim_on_frame(sim_frame_callback_t callback);
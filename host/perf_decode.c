@@ -0,0 +1,151 @@
+// Resume uma captura da saída USB do firmware (ou de simon_bench -p): lê as
+// linhas '@' de perfPoll e ignora o resto.
+//
+// Uso: perf_decode [captura.txt]    (sem arquivo, lê da entrada padrão)
+//
+// Como os acumulados são desde o boot, o resumo usa o último relatório; as
+// taxas são calculadas entre o primeiro e o último relatório da captura.
+// Os percentis vêm do histograma e são o limite superior da faixa.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "perf.h"
+
+#define MAX_STATS 16
+
+typedef struct {
+    char name[32];
+    unsigned long count, min_us, max_us;
+    unsigned long long sum_us;
+    unsigned long hist[PERF_HIST_BINS];
+} decoded_stat_t;
+
+typedef struct {
+    unsigned long long t_us;
+    unsigned long frames_submitted, frames_transmitted, button_events, button_dropped;
+} decoded_counters_t;
+
+static decoded_stat_t stats[MAX_STATS];
+static int stat_count;
+
+static decoded_stat_t *findStat(const char *name) {
+    for (int i = 0; i < stat_count; i++) {
+        if (!strcmp(stats[i].name, name))
+            return &stats[i];
+    }
+    if (stat_count == MAX_STATS)
+        return NULL;
+    decoded_stat_t *s = &stats[stat_count++];
+    snprintf(s->name, sizeof(s->name), "%s", name);
+    return s;
+}
+
+// Limite superior (µs) da faixa onde cai o percentil p
+static unsigned long percentile(const decoded_stat_t *s, unsigned p) {
+    unsigned long long target = ((unsigned long long)s->count * p + 99) / 100, seen = 0;
+    for (int b = 0; b < PERF_HIST_BINS; b++) {
+        seen += s->hist[b];
+        if (seen >= target && seen) {
+            unsigned long bound = b ? (1ul << b) - 1 : 0;
+            return b == PERF_HIST_BINS - 1 || bound > s->max_us ? s->max_us : bound;
+        }
+    }
+    return s->max_us;
+}
+
+// Lê os campos de uma linha "@s"
+static bool parseStat(char *line) {
+    char name[32];
+    decoded_stat_t v;
+    int used;
+    if (sscanf(line, "@s %31s %lu %llu %lu %lu%n", name, &v.count, &v.sum_us, &v.min_us,
+               &v.max_us, &used) != 5)
+        return false;
+    char *p = line + used;
+    for (int b = 0; b < PERF_HIST_BINS; b++) {
+        char *end;
+        v.hist[b] = strtoul(p, &end, 10);
+        if (end == p)
+            return false;
+        p = end;
+    }
+    decoded_stat_t *s = findStat(name);
+    if (s) {
+        memcpy(v.name, s->name, sizeof(v.name));
+        *s = v;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    FILE *f = stdin;
+    if (argc > 1) {
+        f = fopen(argv[1], "r");
+        if (!f) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    int dual_core = -1, dither = 0, lanes = 0, led_count = 0;
+    decoded_counters_t first = {0}, last = {0};
+    unsigned reports = 0, bad_lines = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] != '@')
+            continue;
+        decoded_counters_t c;
+        if (!strncmp(line, "@b ", 3)) {
+            if (sscanf(line, "@b %d %d %d %d", &dual_core, &dither, &lanes, &led_count) != 4)
+                bad_lines++;
+        } else if (!strncmp(line, "@c ", 3)) {
+            if (sscanf(line, "@c %llu %lu %lu %lu %lu", &c.t_us, &c.frames_submitted,
+                       &c.frames_transmitted, &c.button_events, &c.button_dropped) != 5) {
+                bad_lines++;
+                continue;
+            }
+            if (reports++ == 0)
+                first = c;
+            last = c;
+        } else if (!strncmp(line, "@s ", 3)) {
+            if (!parseStat(line))
+                bad_lines++;
+        }
+    }
+    if (f != stdin)
+        fclose(f);
+
+    if (reports == 0) {
+        fprintf(stderr, "perf_decode: nenhum relatório encontrado\n");
+        return 1;
+    }
+
+    if (dual_core >= 0) {
+        printf("build: %s, %s, %d fita(s), %d LEDs\n", dual_core ? "dois cores" : "um core",
+               dither ? "com dithering" : "sem dithering", lanes, led_count);
+    }
+    double span_s = (last.t_us - first.t_us) / 1e6;
+    printf("captura: %u relatorios em %.1f s%s\n", reports, span_s,
+           bad_lines ? " (com linhas inválidas ignoradas)" : "");
+    printf("quadros: %lu apresentados, %lu transmitidos", last.frames_submitted, last.frames_transmitted);
+    if (span_s > 0) {
+        printf(" (%.1f/s transmitidos na captura)",
+               (last.frames_transmitted - first.frames_transmitted) / span_s);
+    }
+    printf("\nbotao: %lu eventos, %lu perdidos\n\n", last.button_events, last.button_dropped);
+
+    printf("%-10s %8s %8s %8s %8s %8s %8s %8s\n", "trecho", "n", "media", "min", "max", "p50", "p90", "p99");
+    for (int i = 0; i < stat_count; i++) {
+        const decoded_stat_t *s = &stats[i];
+        if (!s->count) {
+            printf("%-10s %8s\n", s->name, "0");
+            continue;
+        }
+        printf("%-10s %8lu %8llu %8lu %8lu %8lu %8lu %8lu\n", s->name, s->count, s->sum_us / s->count,
+               s->min_us, s->max_us, percentile(s, 50), percentile(s, 90), percentile(s, 99));
+    }
+    printf("(tempos em us)\n");
+    return 0;
+}
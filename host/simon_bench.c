@@ -0,0 +1,338 @@
+// Reproduz um traço de entrada gravado sobre o hardware simulado e mede o
+// custo de renderização, os quadros enviados e a latência entrada -> quadro.
+//
+// Uso: simon_bench <traço> [-f quadros.csv] [-p] [-2] [-b brilho] [-x medida min max]
+//   -p   imprime também as linhas de medidas do firmware (perfPoll), que
+//        podem ser resumidas por perf_decode
+//   -2   modelo do modo dual-core: o renderizador tem o seu próprio tick,
+//        defasado meio período do tick do jogo, e roda também assim que o
+//        jogo envia um comando (como o core 1 acordado por __sev)
+//   -b   brilho global (npSetBrightness) em vez do padrão
+//   -x   acrescenta uma faixa esperada, ou substitui a do traço
+//
+// Formato do traço (uma linha por evento, tempos em µs, em ordem):
+//   seed <n>               semente da primeira partida (gameReplay)
+//   geometry <colunas> <linhas> <painéis x> <painéis y> <fitas>
+//                          geometria para a qual o traço foi gerado; com
+//                          outra geometria a reprodução é pulada (código 77)
+//   axes <t> <x> <y>       valores crus do ADC de VRx e VRy (0..4095)
+//   button <t> <0|1>       botão solto (0) ou pressionado (1)
+//   end <t>                fim da reprodução
+//   expect <medida> <min> <max>
+//                          faixa aceita de uma medida do resultado:
+//                          transmitidos, sequencia, recorde, latencia_media
+//                          ou latencia_max (µs)
+// Linhas vazias e iniciadas por '#' são ignoradas. Se alguma medida sair da
+// faixa, simon_bench termina com código 1 (é assim que o CTest o usa).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "game.h"
+#include "hal_sim.h"
+#include "joystick.h"
+#include "neopixel.h"
+#include "perf.h"
+#include "render.h"
+#include "scores.h"
+
+typedef enum {
+    TRACE_AXES,
+    TRACE_BUTTON
+} trace_type_t;
+
+typedef struct {
+    uint64_t time_us;
+    trace_type_t type;
+    uint16_t a, b;
+} trace_event_t;
+
+typedef struct {
+    char name[24];
+    unsigned long long min, max;
+} trace_expect_t;
+
+#define MAX_EXPECTS 16
+
+static trace_event_t *trace;
+static size_t trace_count;
+static trace_expect_t expects[MAX_EXPECTS];
+static size_t expect_count;
+static unsigned trace_seed = 1;
+static uint64_t trace_end_us;
+static bool trace_geometry_ok = true;
+
+static FILE *frames_out;
+
+// Defasagem do tick do renderizador no modelo dual-core
+#define BENCH_RENDER_PHASE_US (GAME_TICK_US / 2)
+
+static size_t next_event;
+static uint64_t render_frames;
+static uint64_t render_ns_sum, render_ns_min = UINT64_MAX, render_ns_max;
+
+static bool loadTrace(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    size_t capacity = 0;
+    char line[256];
+    unsigned line_no = 0;
+    while (fgets(line, sizeof(line), f)) {
+        line_no++;
+        char cmd[16];
+        unsigned long long t;
+        unsigned a, b;
+        if (line[0] == '#' || sscanf(line, "%15s", cmd) != 1)
+            continue;
+
+        if (trace_count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            trace = realloc(trace, capacity * sizeof(*trace));
+        }
+        if (!strcmp(cmd, "seed") && sscanf(line, "%*s %u", &a) == 1) {
+            trace_seed = a;
+        } else if (!strcmp(cmd, "axes") && sscanf(line, "%*s %llu %u %u", &t, &a, &b) == 3) {
+            trace[trace_count++] = (trace_event_t){t, TRACE_AXES, a, b};
+        } else if (!strcmp(cmd, "button") && sscanf(line, "%*s %llu %u", &t, &a) == 2) {
+            trace[trace_count++] = (trace_event_t){t, TRACE_BUTTON, a, 0};
+        } else if (!strcmp(cmd, "geometry")) {
+            unsigned g[5];
+            if (sscanf(line, "%*s %u %u %u %u %u", &g[0], &g[1], &g[2], &g[3], &g[4]) != 5) {
+                fprintf(stderr, "%s:%u: linha inválida\n", path, line_no);
+                fclose(f);
+                return false;
+            }
+            trace_geometry_ok = g[0] == NP_PANEL_COLS && g[1] == NP_PANEL_ROWS && g[2] == NP_PANELS_X &&
+                                g[3] == NP_PANELS_Y && g[4] == NP_LANES;
+        } else if (!strcmp(cmd, "end") && sscanf(line, "%*s %llu", &t) == 1) {
+            trace_end_us = t;
+        } else if (!strcmp(cmd, "expect") && expect_count < MAX_EXPECTS &&
+                   sscanf(line, "%*s %23s %llu %llu", expects[expect_count].name,
+                          &expects[expect_count].min, &expects[expect_count].max) == 3) {
+            expect_count++;
+        } else {
+            fprintf(stderr, "%s:%u: linha inválida\n", path, line_no);
+            fclose(f);
+            return false;
+        }
+    }
+    fclose(f);
+
+    if (!trace_end_us && trace_count)
+        trace_end_us = trace[trace_count - 1].time_us;
+    return true;
+}
+
+static void applyEvent(const trace_event_t *ev) {
+    if (ev->type == TRACE_AXES) {
+        sim_set_adc(ADC_CHANNEL_1, ev->a); // VRx
+        sim_set_adc(ADC_CHANNEL_0, ev->b); // VRy
+    } else {
+        sim_set_button(ev->a != 0);
+    }
+}
+
+static void writeFrame(uint64_t time_us, const uint32_t *words, uint count) {
+    fprintf(frames_out, "%llu,%u", (unsigned long long)time_us, count);
+    for (uint i = 0; i < count; i++)
+        fprintf(frames_out, ",%06x", words[i] >> 8);
+    fputc('\n', frames_out);
+}
+
+static uint64_t wallNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Acrescenta uma faixa esperada; uma faixa com o mesmo nome é substituída
+static bool addExpect(const char *name, const char *min, const char *max) {
+    size_t i = 0;
+    while (i < expect_count && strcmp(expects[i].name, name))
+        i++;
+    if (i == MAX_EXPECTS)
+        return false;
+    snprintf(expects[i].name, sizeof(expects[i].name), "%s", name);
+    expects[i].min = strtoull(min, NULL, 10);
+    expects[i].max = strtoull(max, NULL, 10);
+    if (i == expect_count)
+        expect_count++;
+    return true;
+}
+
+// Confere as faixas de expect contra as medidas da reprodução
+static bool checkExpects(const char **names, const unsigned long long *values, size_t count) {
+    bool ok = true;
+    for (size_t i = 0; i < expect_count; i++) {
+        const trace_expect_t *e = &expects[i];
+        size_t m = 0;
+        while (m < count && strcmp(names[m], e->name))
+            m++;
+        if (m == count) {
+            printf("FALHOU: medida desconhecida '%s'\n", e->name);
+            ok = false;
+        } else if (values[m] < e->min || values[m] > e->max) {
+            printf("FALHOU: %s = %llu, esperado entre %llu e %llu\n", e->name, values[m], e->min, e->max);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Avança o tempo simulado até t aplicando os eventos do traço no caminho
+static void advanceTo(uint64_t t) {
+    while (next_event < trace_count && trace[next_event].time_us <= t) {
+        sim_advance_to(trace[next_event].time_us);
+        applyEvent(&trace[next_event++]);
+    }
+    sim_advance_to(t);
+}
+
+// renderTask medido; o custo só conta nos ticks que de fato produziram um quadro
+static void benchRender(uint64_t now) {
+    uint32_t transmitted = np_frames_transmitted;
+    uint64_t start = wallNs();
+    renderTask(now);
+    uint64_t elapsed = wallNs() - start;
+
+    if (np_frames_transmitted != transmitted) {
+        render_frames++;
+        render_ns_sum += elapsed;
+        if (elapsed < render_ns_min)
+            render_ns_min = elapsed;
+        if (elapsed > render_ns_max)
+            render_ns_max = elapsed;
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *trace_path = NULL;
+    const char *frames_path = NULL;
+    bool perf_stream = false;
+    bool dual_core = false;
+    int brightness = -1;
+    const char **extra_expects = calloc(argc, sizeof(*extra_expects));
+    int extra_count = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-f") && i + 1 < argc)
+            frames_path = argv[++i];
+        else if (!strcmp(argv[i], "-p"))
+            perf_stream = true;
+        else if (!strcmp(argv[i], "-2"))
+            dual_core = true;
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc)
+            brightness = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-x") && i + 3 < argc) {
+            for (int k = 0; k < 3; k++)
+                extra_expects[extra_count++] = argv[++i];
+        }
+        else
+            trace_path = argv[i];
+    }
+    if (!trace_path) {
+        fprintf(stderr, "uso: %s <traço> [-f quadros.csv] [-p] [-2] [-b brilho] [-x medida min max]\n", argv[0]);
+        return 2;
+    }
+    if (!loadTrace(trace_path))
+        return 1;
+    if (!trace_geometry_ok) {
+        printf("%s: gerado para outra geometria da matriz, reprodução pulada\n", trace_path);
+        return 77;
+    }
+    for (int i = 0; i < extra_count; i += 3) {
+        if (!addExpect(extra_expects[i], extra_expects[i + 1], extra_expects[i + 2])) {
+            fprintf(stderr, "simon_bench: faixas esperadas demais\n");
+            return 1;
+        }
+    }
+    free(extra_expects);
+    if (frames_path) {
+        frames_out = fopen(frames_path, "w");
+        if (!frames_out) {
+            perror(frames_path);
+            return 1;
+        }
+        sim_on_frame(writeFrame);
+    }
+
+    scoresInit();
+    gameReplay(trace_seed);
+    setup_joystick();
+    renderInit();
+    if (brightness >= 0)
+        npSetBrightness(brightness);
+
+    uint64_t ticks = 0;
+    int longest_sequence = 0;
+
+    for (uint64_t now = GAME_TICK_US; now <= trace_end_us; now += GAME_TICK_US) {
+        if (dual_core) {
+            // Tick do core 1, entre dois ticks do jogo
+            uint64_t render_now = now - BENCH_RENDER_PHASE_US;
+            advanceTo(render_now);
+            benchRender(render_now);
+        }
+        advanceTo(now);
+
+        gameUpdate(now);
+        if (sequence_length > longest_sequence)
+            longest_sequence = sequence_length;
+
+        if (!dual_core || renderHasCommands())
+            benchRender(now);
+        ticks++;
+
+        if (perf_stream)
+            perfPoll(now);
+    }
+
+    if (perf_stream)
+        perfFlush(trace_end_us);
+
+    printf("traco: %s (%zu eventos, %.3f s simulados, semente %u, %s)\n",
+           trace_path, trace_count, trace_end_us / 1e6, trace_seed,
+           dual_core ? "modelo dual-core" : "um core");
+    printf("ticks: %llu\n", (unsigned long long)ticks);
+    printf("quadros: %lu apresentados, %lu transmitidos\n",
+           (unsigned long)np_frames_submitted, (unsigned long)np_frames_transmitted);
+    const perf_stat_t *latency = &perf_stats[PERF_LATENCY];
+    if (latency->count) {
+        printf("latencia entrada->quadro: %lu medidas, media %llu us, min %lu us, max %lu us\n",
+               (unsigned long)latency->count, (unsigned long long)(latency->sum_us / latency->count),
+               (unsigned long)latency->min_us, (unsigned long)latency->max_us);
+    } else {
+        printf("latencia entrada->quadro: nenhuma medida\n");
+    }
+    if (render_frames) {
+        printf("custo de renderizacao por quadro: media %llu ns, min %llu ns, max %llu ns\n",
+               (unsigned long long)(render_ns_sum / render_frames),
+               (unsigned long long)render_ns_min, (unsigned long long)render_ns_max);
+    }
+    printf("maior sequencia: %d\n", longest_sequence);
+    const score_record_t *best = scoresBest();
+    if (best) {
+        printf("recorde registrado: %lu rodadas (semente %lu), %lu setores apagados\n",
+               (unsigned long)best->score, (unsigned long)best->seed, (unsigned long)sim_store_erases);
+    }
+
+    const char *names[] = {"transmitidos", "sequencia", "recorde", "latencia_media", "latencia_max"};
+    const unsigned long long values[] = {
+        np_frames_transmitted,
+        (unsigned long long)longest_sequence,
+        best ? best->score : 0,
+        latency->count ? latency->sum_us / latency->count : 0,
+        latency->count ? latency->max_us : 0
+    };
+    bool ok = checkExpects(names, values, sizeof(values) / sizeof(values[0]));
+
+    if (frames_out)
+        fclose(frames_out);
+    free(trace);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// Gera o traço de entrada de uma partida para simon_bench: o jogador acerta
+// algumas rodadas e erra de propósito na seguinte. As posições vêm de
+// sequenceStep() e da geometria de panel.h, e os tempos dos prazos do jogo
+// e do renderizador, então o traço acompanha mudanças nesses valores.
+//
+// Uso: trace_gen [-s semente] [-r rodadas] > traço
+//
+// host/traces/five_rounds.trace é a saída de trace_gen -s 7 -r 5.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game.h"
+#include "render.h"
+
+#define TRACE_MARGIN_US 50000   // Folga depois de cada prazo do jogo
+#define TRACE_HOLD_US 80000     // Tempo com o botão pressionado
+#define TRACE_CENTER 2048
+
+static uint64_t t = 0;
+static int cursor_x = 1, cursor_y = 1; // Posição inicial de led_x, led_y
+static unsigned presses = 0;
+
+// Coordenadas do LED led na matriz
+static void ledPosition(int led, int *x, int *y) {
+    for (*y = 0; *y < NP_ROWS; (*y)++) {
+        for (*x = 0; *x < NP_COLS; (*x)++) {
+            if (panelLedIndex(*x, *y) == led)
+                return;
+        }
+    }
+}
+
+// Inclina um eixo até o cursor andar steps posições e volta ao centro
+static void tilt(int steps, bool x_axis, int value) {
+    if (!steps)
+        return;
+    printf("axes %llu %d %d\n", (unsigned long long)t, x_axis ? value : TRACE_CENTER,
+           x_axis ? TRACE_CENTER : value);
+    t += (uint64_t)(abs(steps) - 1) * CURSOR_REPEAT_MS * 1000 + TRACE_MARGIN_US;
+    printf("axes %llu %d %d\n", (unsigned long long)t, TRACE_CENTER, TRACE_CENTER);
+    t += TRACE_MARGIN_US + 10000;
+}
+
+// Leva o cursor ao LED led: x baixo incrementa led_x, y alto incrementa led_y
+static void moveTo(int led) {
+    int x, y;
+    ledPosition(led, &x, &y);
+    tilt(x - cursor_x, true, x > cursor_x ? 0 : 4095);
+    tilt(y - cursor_y, false, y > cursor_y ? 4095 : 0);
+    cursor_x = x;
+    cursor_y = y;
+}
+
+// Clique com a borda em fases diferentes do tick, para a latência variar
+static void press() {
+    uint64_t phase = (presses++ * 1370 + 230) % GAME_TICK_US;
+    printf("button %llu 1\n", (unsigned long long)(t + phase));
+    t += TRACE_HOLD_US;
+    printf("button %llu 0\n", (unsigned long long)t);
+}
+
+// Início da entrada da rodada de steps passos, com a exibição começando em show
+static uint64_t inputStart(uint64_t show, int steps) {
+    return show + (SHOW_LEAD_MS + (uint64_t)steps * (SHOW_ON_MS + SHOW_OFF_MS)) * 1000 + TRACE_MARGIN_US;
+}
+
+int main(int argc, char **argv) {
+    uint32_t seed = 7;
+    int rounds = 5;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            rounds = atoi(argv[++i]);
+        } else {
+            fprintf(stderr, "uso: %s [-s semente] [-r rodadas] > traço\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("# %d rodadas corretas seguidas de um erro proposital na seguinte.\n", rounds);
+    printf("# Gerado por host/trace_gen -s %lu -r %d; tempos em µs. Os cliques caem em\n",
+           (unsigned long)seed, rounds);
+    printf("# fases diferentes do tick de %d µs.\n", GAME_TICK_US);
+    printf("seed %lu\n", (unsigned long)seed);
+    printf("geometry %d %d %d %d %d\n", NP_PANEL_COLS, NP_PANEL_ROWS, NP_PANELS_X, NP_PANELS_Y, NP_LANES);
+    printf("# Resultado esperado (simon_bench sai com erro fora das faixas). A latência\n");
+    printf("# até o quadro ir para o fio não pode passar de um tick.\n");
+    printf("expect sequencia %d %d\n", rounds + 1, rounds + 1);
+    printf("expect recorde %d %d\n", rounds, rounds);
+    printf("expect latencia_max 0 %d\n", GAME_TICK_US);
+
+    // O primeiro tick reinicia o jogo e começa a exibição
+    uint64_t show = GAME_TICK_US;
+    for (int r = 1; r <= rounds; r++) {
+        t = inputStart(show, r);
+        uint64_t last_press = 0;
+        for (int k = 0; k < r; k++) {
+            moveTo(sequenceStep(seed, k));
+            last_press = t;
+            press();
+            t += SUCCESS_MS * 1000 + TRACE_MARGIN_US;
+        }
+        // Depois do último acerto: LED verde e sinal de acerto
+        show = last_press + (SUCCESS_MS + ROUND_PAUSE_MS) * 1000 + TRACE_MARGIN_US;
+    }
+
+    // Erro proposital no primeiro passo da rodada seguinte
+    t = inputStart(show, rounds + 1);
+    moveTo((sequenceStep(seed, 0) + 1) % LED_COUNT);
+    press();
+    t += (2 * FLASH_MS * FLASH_TIMES + FAILURE_PAUSE_MS + SHOW_LEAD_MS) * 1000;
+    printf("end %llu\n", (unsigned long long)t);
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "joystick.h"
+
+// Amostragem contínua do joystick: o ADC alterna sozinho entre os dois
+// canais (round robin) e as amostras chegam a um buffer circular sem a CPU.
+// Amostras pares são do canal 0 e ímpares do canal 1.
+#define JOY_SAMPLE_HZ 2000          // Total, dividido entre os dois eixos
+#define JOY_RING_SAMPLES 32         // Potência de 2, número par
+#define JOY_FILTER_SHIFT 2          // IIR: y += (x - y) / 4
+#define JOY_CENTER 2048
+#define JOY_DEADZONE_ENTER 1000     // Distância do centro para inclinar
+#define JOY_DEADZONE_EXIT 600       // Distância do centro para voltar ao repouso
+
+static uint16_t joy_ring[JOY_RING_SAMPLES] __attribute__((aligned(JOY_RING_SAMPLES * sizeof(uint16_t))));
+static uint32_t joy_read_index = 0;  // Próxima amostra a filtrar
+// Valores filtrados por canal do ADC, com 4 bits fracionários
+static int32_t joy_filtered[2] = {JOY_CENTER << 4, JOY_CENTER << 4};
+static int8_t joy_dir[2] = {0, 0};   // Direção com histerese: -1, 0 ou 1
+
+// Passa pelo filtro as amostras escritas desde a última leitura
+static void joystickFilter() {
+    uint32_t write_index = hal_adc_write_index();
+
+    while (joy_read_index != write_index) {
+        int32_t sample = joy_ring[joy_read_index] << 4;
+        int32_t *f = &joy_filtered[joy_read_index & 1];
+        *f += (sample - *f) >> JOY_FILTER_SHIFT;
+        joy_read_index = (joy_read_index + 1) % JOY_RING_SAMPLES;
+    }
+}
+
+// Lê os valores filtrados dos eixos do joystick, sem bloquear
+void joystick_read_axis(uint16_t *eixo_x, uint16_t *eixo_y){
+    joystickFilter();
+    *eixo_x = joy_filtered[ADC_CHANNEL_1] >> 4;
+    *eixo_y = joy_filtered[ADC_CHANNEL_0] >> 4;
+} 
+
+// Direção de um eixo com zona morta e histerese: inclina ao passar de
+// JOY_DEADZONE_ENTER e só volta ao repouso abaixo de JOY_DEADZONE_EXIT
+int joystickAxisDir(uint channel, uint16_t value) {
+    int offset = (int)value - JOY_CENTER;
+    int8_t *dir = &joy_dir[channel];
+
+    if (*dir == 0) {
+        if (offset > JOY_DEADZONE_ENTER)
+            *dir = 1;
+        else if (offset < -JOY_DEADZONE_ENTER)
+            *dir = -1;
+    } else if (*dir * offset < JOY_DEADZONE_EXIT) {
+        *dir = 0;
+    }
+    return *dir;
+}
+
+// Fila circular de produtor único (IRQ do GPIO/alarme) e consumidor único
+// (laço do jogo). Cada lado escreve apenas o seu índice, então não há trava.
+#define BUTTON_QUEUE_SIZE 16 // Potência de 2
+#define BUTTON_DEBOUNCE_US 20000 // Janela em que novas bordas são ignoradas
+
+static button_event_t button_queue[BUTTON_QUEUE_SIZE];
+static volatile uint32_t button_head = 0;   // Escrito só pelo produtor
+static volatile uint32_t button_tail = 0;   // Escrito só pelo consumidor
+volatile uint32_t button_events = 0;        // Eventos publicados
+volatile uint32_t button_dropped = 0;       // Eventos perdidos com a fila cheia
+
+static bool button_pressed = false;         // Último estado publicado
+static volatile bool button_locked = false; // Dentro da janela de debounce
+static uint64_t button_last_edge = 0;       // Última borda durante a janela
+
+static void buttonPush(button_event_type_t type, uint64_t time_us) {
+    uint32_t head = button_head;
+    if (head - button_tail == BUTTON_QUEUE_SIZE) {
+        button_dropped++;
+        return;
+    }
+    button_queue[head % BUTTON_QUEUE_SIZE] = (button_event_t){time_us, type};
+    hal_dmb(); // Evento visível antes do novo índice
+    button_head = head + 1;
+    button_events++;
+}
+
+// Retira o evento mais antigo da fila; retorna false se estiver vazia
+bool buttonPop(button_event_t *event) {
+    uint32_t tail = button_tail;
+    if (tail == button_head)
+        return false;
+    hal_dmb();
+    *event = button_queue[tail % BUTTON_QUEUE_SIZE];
+    hal_dmb(); // Leitura concluída antes de liberar a posição
+    button_tail = tail + 1;
+    return true;
+}
+
+// Fim da janela de debounce: se o nível final for diferente do publicado
+// (ex.: um toque mais curto que a janela), publica a borda que faltou e abre
+// uma nova janela; senão volta a aceitar bordas.
+static int64_t buttonDebounceDone() {
+    bool pressed = !hal_gpio_get(SW);
+    if (pressed != button_pressed) {
+        button_pressed = pressed;
+        buttonPush(pressed ? BUTTON_PRESS : BUTTON_RELEASE, button_last_edge);
+        return BUTTON_DEBOUNCE_US;
+    }
+    button_locked = false;
+    return 0;
+}
+
+// Borda no pino do botão: a primeira borda fora da janela de debounce é
+// publicada imediatamente com o nível lido do pino; as seguintes
+// (trepidação) só são anotadas. Um pulso que já acabou quando o pino é
+// lido não muda o nível e não gera evento.
+static void buttonEdge(uint64_t now) {
+    button_last_edge = now;
+    if (button_locked)
+        return;
+    bool pressed = !hal_gpio_get(SW);
+    if (pressed == button_pressed)
+        return;
+    button_pressed = pressed;
+    buttonPush(pressed ? BUTTON_PRESS : BUTTON_RELEASE, now);
+
+    button_locked = true;
+    if (!hal_alarm_in_us(BUTTON_DEBOUNCE_US, buttonDebounceDone))
+        button_locked = false; // Sem alarme livre: não trava o botão
+}
+
+// Configura o joystick
+void setup_joystick(){
+    hal_button_init(SW, buttonEdge);
+    // Parte do nível atual: um botão segurado desde o boot gera só o RELEASE
+    button_pressed = !hal_gpio_get(SW);
+
+    // Conversão contínua em round robin, começando pelo canal 0 para que a
+    // paridade do índice no buffer identifique o canal
+    hal_adc_start(joy_ring, JOY_RING_SAMPLES, (1u << ADC_CHANNEL_0) | (1u << ADC_CHANNEL_1), JOY_SAMPLE_HZ);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "hal.h"
+
+// Canais do ADC de cada eixo e pino do botão do joystick
+#define ADC_CHANNEL_0 0
+#define ADC_CHANNEL_1 1
+#define SW 22
+
+// Eventos do botão, com o instante (hal_time_us) da borda que os originou
+typedef enum {
+    BUTTON_PRESS,
+    BUTTON_RELEASE
+} button_event_type_t;
+
+typedef struct {
+    uint64_t time_us;
+    button_event_type_t type;
+} button_event_t;
+
+// Eventos publicados e eventos perdidos com a fila do botão cheia
+extern volatile uint32_t button_events;
+extern volatile uint32_t button_dropped;
+
+void setup_joystick();
+void joystick_read_axis(uint16_t *eixo_x, uint16_t *eixo_y);
+int joystickAxisDir(uint channel, uint16_t value);
+bool buttonPop(button_event_t *event);
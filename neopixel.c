@@ -0,0 +1,216 @@
+#include <string.h>
+
+#include "neopixel.h"
+
+int global_brightness = NP_BRIGHTNESS;
+
+// Dois framebuffers: o "back" (leds) é onde o jogo desenha e o "front" é o
+// que está sendo enviado para a matriz.
+static uint32_t np_buffers[2][LED_COUNT];
+uint32_t *leds = np_buffers[0];             // Buffer de desenho (back)
+static uint32_t *np_front = np_buffers[1];  // Buffer em transmissão (front)
+// Verdadeiro enquanto um quadro está no fio ou o tempo de latch não terminou.
+static volatile bool np_busy = false;
+
+// Posição na cadeia de cada coordenada, calculada uma vez em npInit
+static uint16_t np_index_lut[NP_ROWS][NP_COLS];
+
+// Pixels do back buffer escritos desde o último envio. Só eles são
+// comparados com o quadro no fio para decidir o que precisa ser enviado.
+#define NP_DIRTY_WORDS ((LED_COUNT + 31) / 32)
+static uint32_t np_dirty[NP_DIRTY_WORDS];
+static bool np_force_full = true;  // Estado real dos LEDs ainda desconhecido
+#define NP_MARK_DIRTY(i) (np_dirty[(i) / 32] |= 1u << ((i) % 32))
+
+volatile uint32_t np_frames_submitted = 0;
+volatile uint32_t np_frames_transmitted = 0;
+
+// Correção gamma 2.2 em ponto fixo 0..65535, calculada fora do dispositivo
+// para ficar em flash: i -> round((i / 255)^2.2 * 65535).
+static const uint16_t np_gamma16[256] = {
+        0,     0,     2,     4,     7,    11,    17,    24,    32,    42,    53,    65,
+       79,    94,   111,   129,   148,   169,   192,   216,   242,   270,   299,   330,
+      362,   396,   432,   469,   508,   549,   591,   635,   681,   729,   779,   830,
+      883,   938,   995,  1053,  1113,  1175,  1239,  1305,  1373,  1443,  1514,  1587,
+     1663,  1740,  1819,  1900,  1983,  2068,  2155,  2243,  2334,  2427,  2521,  2618,
+     2717,  2817,  2920,  3024,  3131,  3240,  3350,  3463,  3578,  3694,  3813,  3934,
+     4057,  4182,  4309,  4438,  4570,  4703,  4838,  4976,  5115,  5257,  5401,  5547,
+     5695,  5845,  5998,  6152,  6309,  6468,  6629,  6792,  6957,  7124,  7294,  7466,
+     7640,  7816,  7994,  8175,  8358,  8543,  8730,  8919,  9111,  9305,  9501,  9699,
+     9900, 10102, 10307, 10515, 10724, 10936, 11150, 11366, 11585, 11806, 12029, 12254,
+    12482, 12712, 12944, 13179, 13416, 13655, 13896, 14140, 14386, 14635, 14885, 15138,
+    15394, 15652, 15912, 16174, 16439, 16706, 16975, 17247, 17521, 17798, 18077, 18358,
+    18642, 18928, 19216, 19507, 19800, 20095, 20393, 20694, 20996, 21301, 21609, 21919,
+    22231, 22546, 22863, 23182, 23504, 23829, 24156, 24485, 24817, 25151, 25487, 25826,
+    26168, 26512, 26858, 27207, 27558, 27912, 28268, 28627, 28988, 29351, 29717, 30086,
+    30457, 30830, 31206, 31585, 31966, 32349, 32735, 33124, 33514, 33908, 34304, 34702,
+    35103, 35507, 35913, 36321, 36732, 37146, 37562, 37981, 38402, 38825, 39252, 39680,
+    40112, 40546, 40982, 41421, 41862, 42306, 42753, 43202, 43654, 44108, 44565, 45025,
+    45487, 45951, 46418, 46888, 47360, 47835, 48313, 48793, 49275, 49761, 50249, 50739,
+    51232, 51728, 52226, 52727, 53230, 53736, 54245, 54756, 55270, 55787, 56306, 56828,
+    57352, 57879, 58409, 58941, 59476, 60014, 60554, 61097, 61642, 62190, 62741, 63295,
+    63851, 64410, 64971, 65535
+};
+
+// Tabela de brilho + gamma em ponto fixo 8.8 (0..0xFF00), reconstruída só
+// quando o brilho muda. Assim npSetLED não faz nenhuma divisão.
+static uint16_t np_lut[256];
+
+#if NP_DITHER
+// Dithering temporal: a parte fracionária da tabela é arredondada com um
+// limiar que varia a cada quadro, evitando degraus em brilhos baixos.
+static uint16_t np_dither = 128;
+static uint8_t np_dither_frame = 0;
+#define NP_SCALE(v) ((np_lut[(v)] + np_dither) >> 8)
+#else
+#define NP_SCALE(v) (np_lut[(v)] >> 8)
+#endif
+
+// Índice de um LED na matriz, pela tabela montada em npInit
+int getLedIndex(int x, int y) {
+    return np_index_lut[y][x];
+}
+
+// Fim do envio e do período de latch: o link está livre para o próximo quadro
+void npTransmitDone() {
+    np_busy = false;
+}
+
+// Altera o brilho global e reconstrói a tabela de brilho + gamma
+void npSetBrightness(uint8_t brightness) {
+    global_brightness = brightness;
+    for (uint i = 0; i < 256; i++) {
+        uint32_t v = (uint32_t)np_gamma16[i] * brightness / 255;
+        np_lut[i] = v - (v >> 8); // 0..65535 -> 0..0xFF00
+    }
+}
+
+// Inicializa os LEDs Neopixel, uma state machine por fita
+void npInit() {
+    static const uint pins[NP_LANES] = {NP_LANE_PINS};
+    for (int y = 0; y < NP_ROWS; y++) {
+        for (int x = 0; x < NP_COLS; x++)
+            np_index_lut[y][x] = panelLedIndex(x, y);
+    }
+    hal_led_init(pins, NP_LANES, NP_LANE_LEDS);
+    memset(np_buffers, 0, sizeof(np_buffers));  // Inicializa LEDs apagados
+    npSetBrightness(global_brightness);
+}
+
+// Palavra GRB de uma cor com o brilho e a gamma atuais
+uint32_t npColor(uint8_t r, uint8_t g, uint8_t b) {
+    return NP_PACK_GRB(NP_SCALE(r), NP_SCALE(g), NP_SCALE(b));
+}
+
+// Configura um LED com determinada cor
+void npSetLED(uint index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < LED_COUNT) {
+        leds[index] = npColor(r, g, b);
+        NP_MARK_DIRTY(index);
+    }
+}
+
+// Apaga todos os LEDs (a tabela sempre leva 0 em 0, então basta zerar)
+void npClear() {
+    memset(leds, 0, sizeof(np_buffers[0]));
+    memset(np_dirty, 0xFF, sizeof(np_dirty));
+}
+
+// Leva o back buffer a um quadro já convertido por peskel_convert (palavras
+// GRB com brilho e gamma aplicados na compilação, na ordem da fita), lido
+// direto da flash. Como um delta calculado na hora contra o buffer atual,
+// só as palavras diferentes são escritas e marcadas como sujas.
+void npSetFrame(const uint32_t *frame) {
+    for (uint i = 0; i < LED_COUNT; i++) {
+        if (leds[i] != frame[i]) {
+            leds[i] = frame[i];
+            NP_MARK_DIRTY(i);
+        }
+    }
+}
+
+// Aplica um quadro delta de peskel_convert: trechos (inicio << 16 | tamanho)
+// seguidos das palavras, até uma palavra 0. Retorna o início do próximo quadro.
+const uint32_t *npApplyDelta(const uint32_t *delta) {
+    for (uint32_t run; (run = *delta++) != 0; delta += run & 0xFFFF) {
+        uint start = run >> 16, len = run & 0xFFFF;
+        if (start + len > LED_COUNT)
+            continue;
+        memcpy(&leds[start], delta, len * sizeof(uint32_t));
+        for (uint i = start; i < start + len; i++)
+            NP_MARK_DIRTY(i);
+    }
+    return delta;
+}
+
+// Indica se ainda há um quadro sendo transmitido (ou em latch)
+bool npIsBusy() {
+    return np_busy;
+}
+
+// Para cada fita, quantos pixels vão para o fio: até o último pixel sujo
+// que difere do quadro no fio. Retorna false se nenhuma fita mudou.
+static bool npChangedCounts(uint *counts) {
+    bool changed = false;
+    for (uint lane = 0; lane < NP_LANES; lane++) {
+        uint base = lane * NP_LANE_LEDS;
+        uint n = np_force_full ? NP_LANE_LEDS : 0;
+        for (uint i = NP_LANE_LEDS; n == 0 && i-- > 0; ) {
+            uint p = base + i;
+            if ((np_dirty[p / 32] >> (p % 32)) & 1 && leds[p] != np_front[p])
+                n = i + 1;
+        }
+        counts[lane] = n;
+        changed |= n != 0;
+    }
+    return changed;
+}
+
+#if NP_DITHER
+// Limiar seguinte: contador de 3 bits invertido (16, 144, 80, 208, ...)
+static void npDitherNext() {
+    uint8_t f = ++np_dither_frame;
+    np_dither = ((((f & 1) << 2) | (f & 2) | ((f >> 2) & 1)) << 5) + 16;
+}
+#endif
+
+// Troca os buffers e inicia o envio do novo front sem bloquear.
+// Um quadro igual ao que está no fio não é enviado. Como cada WS2812 mantém
+// a cor até receber novos dados, cada fita só transmite os pixels até o seu
+// último alterado. Retorna false, sem alterar nada, se o quadro mudou mas o
+// anterior ainda estiver no fio.
+// Com NP_DITHER o limiar avança a cada quadro apresentado, enviado ou não:
+// um quadro parado, recomposto no tick seguinte, sai com o novo limiar e
+// só deixa de ser enviado se nenhum pixel mudar com ele.
+bool npPresent() {
+    uint counts[NP_LANES];
+    bool changed = npChangedCounts(counts);
+    if (changed && np_busy)
+        return false;
+    memset(np_dirty, 0, sizeof(np_dirty));
+    np_frames_submitted++;
+#if NP_DITHER
+    npDitherNext();
+#endif
+    if (!changed)
+        return true;
+    np_busy = true;
+    np_force_full = false;
+    np_frames_transmitted++;
+
+    uint32_t *front = leds;
+    leds = np_front;
+    np_front = front;
+    // O desenho é incremental, então o novo back parte do quadro apresentado
+    memcpy(leds, np_front, sizeof(np_buffers[0]));
+
+    hal_led_put(np_front, counts);
+    return true;
+}
+
+// Envia os dados dos LEDs para o Neopixel. Só espera se o quadro anterior
+// ainda estiver sendo transmitido; o envio em si acontece em segundo plano.
+void npWrite() {
+    while (!npPresent())
+        tight_loop_contents();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "hal.h"
+#include "panel.h"
+
+#define LED_PIN 7
+
+// Pino de cada fita, uma por lane (veja panel.h)
+#ifndef NP_LANE_PINS
+#define NP_LANE_PINS LED_PIN
+#endif
+
+// Cada LED é uma palavra GRB já empacotada (0xGGRRBB00), no formato que o
+// programa PIO consome: bits mais significativos primeiro, 24 bits por LED.
+#define NP_PACK_GRB(r, g, b) (((uint32_t)(g) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(b) << 8))
+
+#ifndef NP_DITHER
+#define NP_DITHER 0
+#endif
+
+// Controle de brilho (use npSetBrightness para alterar o brilho)
+extern int global_brightness;
+
+// Buffer de desenho (back) do quadro atual
+extern uint32_t *leds;
+
+// Quadros entregues a npPresent e quadros que de fato foram para o fio
+extern volatile uint32_t np_frames_submitted;
+extern volatile uint32_t np_frames_transmitted;
+
+int getLedIndex(int x, int y);
+
+void npInit();
+void npSetBrightness(uint8_t brightness);
+uint32_t npColor(uint8_t r, uint8_t g, uint8_t b);
+void npSetLED(uint index, uint8_t r, uint8_t g, uint8_t b);
+void npClear();
+void npSetFrame(const uint32_t *frame);
+const uint32_t *npApplyDelta(const uint32_t *delta);
+bool npIsBusy();
+bool npPresent();
+void npWrite();
+
+// Chamado pela camada de hardware quando o quadro e o latch terminam
+void npTransmitDone();
@@ -1,215 +1,166 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
-#include "hardware/pio.h"
-#include "hardware/gpio.h"
-#include "hardware/adc.h"
-#include <stdlib.h>
-
-#include "ws2818b.pio.h" 
-
-#define LED_COUNT 25
-#define LED_PIN 7
-#define MAX_SEQUENCE 10
-
-// Pinos do joystickr
-const int vRx = 20; 
-const int vRy = 27;
-const int ADC_CHANNEL_0 = 0;
-
-const int ADC_CHANNEL_1 = 1;
-const int SW = 22;
-
-// Controle de brilho e posição do LED
-int global_brightness = 40;
-int led_x = 1, led_y = 1;
-
-// Estrutura para armazenar cores RGB dos LEDs
-typedef struct {
-    uint8_t G, R, B;
-} pixel_t;
-
-pixel_t leds[LED_COUNT]; // Buffer de LEDs
-PIO np_pio;
-uint sm;
-
-// Sequência do jogo
-int sequence[MAX_SEQUENCE];
-int player_index = 0;
-int sequence_length = 1;
-
-// Calcula o índice de um LED na matriz 5x5
-int getLedIndex(int x, int y) {
-    if (y % 2 == 0) {
-        return (y * 5) + x;  // Linhas pares (esquerda → direita)
-    } else {
-        return (y * 5) + (4 - x); // Linhas ímpares (direita → esquerda)
+#if SIMON_DUAL_CORE
+#include "pico/multicore.h"
+#endif
+#ifdef NP_BENCHMARK
+#include "hardware/structs/systick.h"
+#endif
+#include "game.h"
+#include "joystick.h"
+#include "neopixel.h"
+#include "perf.h"
+#include "render.h"
+#include "scores.h"
+
+#ifdef NP_BENCHMARK
+// Implementação anterior de npSetLED, mantida só como referência de medida
+static void npSetLEDDiv(uint index, uint8_t r, uint8_t g, uint8_t b) {
+    if (index < LED_COUNT) {
+        leds[index] = NP_PACK_GRB(r * global_brightness / 255, g * global_brightness / 255, b * global_brightness / 255);
     }
 }
 
-// Inicializa os LEDs Neopixel
-void npInit(uint pin) {
-    uint offset = pio_add_program(pio0, &ws2818b_program);
-    np_pio = pio0;
-    sm = pio_claim_unused_sm(np_pio, true);
-    ws2818b_program_init(np_pio, sm, offset, pin, 800000.f);
-    pio_sm_set_enabled(np_pio, sm, true);
-    
+// Implementação anterior de npClear
+static void npClearDiv() {
     for (uint i = 0; i < LED_COUNT; i++)
-        leds[i] = (pixel_t){0, 0, 0};  // Inicializa LEDs apagados
+        npSetLEDDiv(i, 0, 0, 0);
 }
 
-// Configura um LED com determinada cor
-void npSetLED(uint index, uint8_t r, uint8_t g, uint8_t b) {
-    if (index < LED_COUNT) {
-        leds[index] = (pixel_t){g * global_brightness / 255, r * global_brightness / 255, b * global_brightness / 255};
-    }
-}
+#define NP_BENCH_FRAMES 1000
 
-// Apaga todos os LEDs
-void npClear() {
-    for (uint i = 0; i < LED_COUNT; i++)
-        npSetLED(i, 0, 0, 0);
+// Ciclos decorridos no SysTick (contador decrescente de 24 bits)
+static inline uint32_t benchElapsed(uint32_t start) {
+    return (start - systick_hw->cvr) & 0xFFFFFF;
 }
 
-// Envia os dados dos LEDs para o Neopixel
-void npWrite() {
-    for (uint i = 0; i < LED_COUNT; i++) {
-        pio_sm_put_blocking(np_pio, sm, leds[i].G);
-        pio_sm_put_blocking(np_pio, sm, leds[i].R);
-        pio_sm_put_blocking(np_pio, sm, leds[i].B);
-    }
-    sleep_us(300);
-}
+// Mede ciclos por npSetLED e por quadro completo (npClear + 25 npSetLED),
+// comparando a tabela com a divisão por canal, e imprime pela USB.
+void npBenchmark() {
+    systick_hw->rvr = 0xFFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // Habilitado, clock do processador
 
-// Faz os LEDs piscarem em vermelho para indicar erro
-void flashRed(uint times) {
-    for (uint i = 0; i < times; i++) {
-        for (uint j = 0; j < LED_COUNT; j++)
-            npSetLED(j, 255, 0, 0);
-        npWrite();
-        sleep_ms(200);
-        npClear();
-        npWrite();
-        sleep_ms(200);
-    }
-} 
+    volatile uint8_t seed = 37; // Evita que o compilador dobre as cores
+    uint32_t div_cycles = 0, lut_cycles = 0, div_frame = 0, lut_frame = 0;
 
-// Lê os valores dos eixos do joystick
-void joystick_read_axis(uint16_t *eixo_x, uint16_t *eixo_y){
-    adc_select_input(ADC_CHANNEL_1);
-    sleep_us(2);
-    *eixo_x = adc_read();
+    for (uint f = 0; f < NP_BENCH_FRAMES; f++) {
+        uint8_t c = seed + f;
 
-    adc_select_input(ADC_CHANNEL_0);
-    sleep_us(2);
-    *eixo_y = adc_read();
-} 
+        uint32_t t = systick_hw->cvr;
+        for (uint i = 0; i < LED_COUNT; i++)
+            npSetLEDDiv(i, c + i, c ^ i, c - i);
+        div_cycles += benchElapsed(t);
 
-// Exibe a sequência de LEDs
-void showSequence() {
-    npClear();
-    npWrite();
-    sleep_ms(500);
+        t = systick_hw->cvr;
+        for (uint i = 0; i < LED_COUNT; i++)
+            npSetLED(i, c + i, c ^ i, c - i);
+        lut_cycles += benchElapsed(t);
+
+        t = systick_hw->cvr;
+        npClearDiv();
+        npSetLEDDiv(f % LED_COUNT, c, c, c);
+        div_frame += benchElapsed(t);
 
-    for (int i = 0; i < sequence_length; i++) {
-        npSetLED(sequence[i], 0, 255, 0); // LEDs verdes
-        npWrite();
-        sleep_ms(500);
+        t = systick_hw->cvr;
         npClear();
-        npWrite();
-        sleep_ms(250);
+        npSetLED(f % LED_COUNT, c, c, c);
+        lut_frame += benchElapsed(t);
     }
+
+    printf("npSetLED: divisao %lu ciclos, tabela %lu ciclos\n",
+           (unsigned long)(div_cycles / (NP_BENCH_FRAMES * LED_COUNT)),
+           (unsigned long)(lut_cycles / (NP_BENCH_FRAMES * LED_COUNT)));
+    printf("quadro (npClear + npSetLED): divisao %lu ciclos, tabela %lu ciclos\n",
+           (unsigned long)(div_frame / NP_BENCH_FRAMES),
+           (unsigned long)(lut_frame / NP_BENCH_FRAMES));
+    npClear();
+}
+#endif
+
+// Inicializa os LEDs no core que vai renderizar
+static void outputInit() {
+    renderInit();
+#ifdef NP_BENCHMARK
+    npBenchmark();
+#endif
 }
 
-// Reinicia o jogo gerando uma nova sequência
-void resetGame() {
-    sequence_length = 1;
-    player_index = 0;
-    
-    for (int i = 0; i < MAX_SEQUENCE; i++)
-        sequence[i] = rand() % LED_COUNT;
+// Marca o próximo tick e acorda o laço principal
+static volatile bool tick_pending = false;
 
-    showSequence();
+static bool gameTickCallback(repeating_timer_t *rt) {
+    tick_pending = true;
+    return true;
 }
 
-// Configura o joystick
-void setup_joystick(){
-    adc_init();
-    adc_gpio_init(vRx);
-    adc_gpio_init(vRy);
-    gpio_init(SW);
-    gpio_set_dir(SW, GPIO_IN);
-    gpio_pull_up(SW);
+#if SIMON_DUAL_CORE
+static volatile bool render_tick_pending = false;
+
+static bool renderTickCallback(repeating_timer_t *rt) {
+    render_tick_pending = true;
+    return true;
 }
 
-// Atualiza a posição do LED com o joystick
-void updateLedPosition() {
-    uint16_t eixo_x, eixo_y;
-    joystick_read_axis(&eixo_x, &eixo_y);
+// Core 1: dono do framebuffer e da saída dos LEDs. O seu próprio pool de
+// alarmes faz a interrupção do tick de renderização cair neste core.
+static void core1Main() {
+    multicore_lockout_victim_init(); // Pausa este core durante a escrita na flash
+    outputInit();
 
-    int max_x = 4, max_y = 4; // Dimensões da matriz
+    alarm_pool_t *pool = alarm_pool_create_with_unused_hardware_alarm(4);
+    repeating_timer_t render_timer;
+    alarm_pool_add_repeating_timer_us(pool, -GAME_TICK_US, renderTickCallback, NULL, &render_timer);
 
-    if (eixo_x > 3000 && led_x > 0){
-        led_x--;
-    } 
-    if (eixo_x < 1000 && led_x < max_x){
-        led_x++;
-    }
-    if (eixo_y > 3000 && led_y < max_y){
-        led_y++;
-    }
-    if (eixo_y < 1000 && led_y > 0){ 
-        led_y--;
-    }
-
-    npClear();
-    int ledIndex = getLedIndex(led_x, led_y);
-    npSetLED(ledIndex, 50, 50, 50); // Indica posição do LED
-    npWrite();
-}
+    while (true) {
+        // Dorme até o próximo tick ou até chegar um comando
+        while (!render_tick_pending && !renderHasCommands())
+            __wfe();
+        render_tick_pending = false;
 
-// Verifica se o botão do joystick foi pressionado
-void checkJoystickClick() {
-    if (!gpio_get(SW)) {
-        sleep_ms(50);
-        if (!gpio_get(SW)) {
-            int current_led_index = getLedIndex(led_x, led_y);
-
-            if (player_index < sequence_length && current_led_index == sequence[player_index]) {
-                npSetLED(current_led_index, 0, 255, 0); // LED verde
-                npWrite();
-                sleep_ms(300);
-
-                player_index++;
-                if (player_index == sequence_length) {
-                    sequence_length++;
-                    player_index = 0;
-                    sleep_ms(500);
-                    showSequence();
-                }
-            } else {
-                flashRed(3);
-                sleep_ms(1000);
-                resetGame();
-            }
-        }
+        renderTask(time_us_64());
     }
 }
+#endif
 
 int main() {
     stdio_init_all();
     sleep_ms(2000);
-    npInit(LED_PIN);
-    npClear();
-    npWrite();
     setup_joystick();
-    srand(time_us_64());
 
-    resetGame();
+    // Recorde salvo na flash; com o botão pressionado na partida, a primeira
+    // partida repete a sequência do recorde
+    scoresInit();
+    const score_record_t *best = scoresBest();
+    if (best) {
+        printf("recorde: %lu rodadas (semente %08lx)\n", (unsigned long)best->score, (unsigned long)best->seed);
+        if (!hal_gpio_get(SW))
+            gameReplay(best->seed);
+    }
+
+#if SIMON_DUAL_CORE
+    multicore_launch_core1(core1Main);
+#else
+    outputInit();
+#endif
+
+    // Período negativo: ticks espaçados a partir do início de cada disparo
+    repeating_timer_t tick_timer;
+    add_repeating_timer_us(-GAME_TICK_US, gameTickCallback, NULL, &tick_timer);
 
     while (true) {
-        updateLedPosition();
-        checkJoystickClick();
-        sleep_ms(100);
-    }    
+        // Dorme até a interrupção do próximo tick
+        while (!tick_pending)
+            __wfe();
+        tick_pending = false;
+
+        uint64_t now = time_us_64();
+        uint32_t start = perfStart();
+        gameUpdate(now);
+#if !SIMON_DUAL_CORE
+        renderTask(now);
+#endif
+        perfPoll(now); // Medidas pela USB, um pedaço por tick
+        perfEnd(PERF_LOOP, start);
+    }
 }
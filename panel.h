@@ -0,0 +1,54 @@
+#pragma once
+
+// Geometria da matriz, fixada na compilação (opções NP_* do CMake).
+//
+// A matriz tem NP_PANELS_X x NP_PANELS_Y painéis de NP_PANEL_COLS x
+// NP_PANEL_ROWS LEDs. Cada painel é uma fita serpentina como a da BitDogLab
+// (linhas pares x crescente, ímpares x decrescente) e os painéis são
+// encadeados linha a linha. A cadeia é dividida igualmente entre NP_LANES
+// fitas ligadas em pinos diferentes e transmitidas em paralelo, cada uma com
+// um trecho contíguo do framebuffer.
+//
+// Usado pelo firmware e por peskel_convert, que convertem as coordenadas
+// (x, y) da mesma forma.
+
+#ifndef NP_PANEL_COLS
+#define NP_PANEL_COLS 5
+#endif
+#ifndef NP_PANEL_ROWS
+#define NP_PANEL_ROWS 5
+#endif
+#ifndef NP_PANELS_X
+#define NP_PANELS_X 1
+#endif
+#ifndef NP_PANELS_Y
+#define NP_PANELS_Y 1
+#endif
+#ifndef NP_LANES
+#define NP_LANES 1
+#endif
+
+#define NP_COLS (NP_PANEL_COLS * NP_PANELS_X)
+#define NP_ROWS (NP_PANEL_ROWS * NP_PANELS_Y)
+#define NP_PANEL_LEDS (NP_PANEL_COLS * NP_PANEL_ROWS)
+#define NP_PANELS (NP_PANELS_X * NP_PANELS_Y)
+#define LED_COUNT (NP_COLS * NP_ROWS)
+#define NP_LANE_LEDS (LED_COUNT / NP_LANES)
+
+// Brilho inicial (0..255) do firmware. peskel_convert aplica o mesmo valor
+// às animações, para que elas saiam com o brilho do resto do jogo.
+#define NP_BRIGHTNESS 40
+
+#if NP_LANES < 1 || NP_LANES > 8 || NP_PANELS % NP_LANES
+#error "NP_LANES deve ser de 1 a 8 e dividir o número de painéis"
+#endif
+
+// Posição na cadeia de LEDs do pixel (x, y). O firmware só chama esta conta
+// para montar a tabela de getLedIndex.
+static inline int panelLedIndex(int x, int y) {
+    int panel = (y / NP_PANEL_ROWS) * NP_PANELS_X + x / NP_PANEL_COLS;
+    int px = x % NP_PANEL_COLS, py = y % NP_PANEL_ROWS;
+    if (py % 2)
+        px = NP_PANEL_COLS - 1 - px; // Linhas ímpares (direita → esquerda)
+    return panel * NP_PANEL_LEDS + py * NP_PANEL_COLS + px;
+}
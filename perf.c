@@ -0,0 +1,104 @@
+#include <stdio.h>
+
+#include "joystick.h"
+#include "neopixel.h"
+#include "perf.h"
+#include "render.h"
+
+#if SIMON_PERF
+
+perf_stat_t perf_stats[PERF_COUNT];
+
+static const char *const perf_names[PERF_COUNT] = {
+    [PERF_PRESENT] = "present",
+    [PERF_INPUT] = "input",
+    [PERF_ANIM_STEP] = "anim_step",
+    [PERF_LOOP] = "loop",
+    [PERF_LATENCY] = "latency",
+};
+
+// Acumula uma medida: contagem, soma, extremos e a faixa do histograma
+void perfRecord(perf_id_t id, uint32_t us) {
+    perf_stat_t *s = &perf_stats[id];
+    if (s->count == 0 || us < s->min_us)
+        s->min_us = us;
+    if (us > s->max_us)
+        s->max_us = us;
+    s->sum_us += us;
+    s->count++;
+
+    uint bin = us ? 32 - __builtin_clz(us) : 0;
+    s->hist[bin < PERF_HIST_BINS ? bin : PERF_HIST_BINS - 1]++;
+}
+
+// Relatório em envio: linha atual (0 = @b, 1 = @c, depois uma @s por
+// medida) e o trecho dela que ainda não saiu
+#define PERF_REPORT_LINES (2 + PERF_COUNT)
+
+static char perf_line[256];
+static uint perf_line_len = 0, perf_line_sent = 0;
+static uint perf_next_line = PERF_REPORT_LINES;  // PERF_REPORT_LINES = nenhum relatório
+
+// Formata uma linha do relatório em perf_line
+static uint perfFormatLine(uint line, uint64_t now) {
+    int n;
+    if (line == 0) {
+        n = snprintf(perf_line, sizeof(perf_line), "@b %d %d %d %d\n",
+                     SIMON_DUAL_CORE, NP_DITHER, NP_LANES, LED_COUNT);
+    } else if (line == 1) {
+        n = snprintf(perf_line, sizeof(perf_line), "@c %llu %lu %lu %lu %lu\n", (unsigned long long)now,
+                     (unsigned long)np_frames_submitted, (unsigned long)np_frames_transmitted,
+                     (unsigned long)button_events, (unsigned long)button_dropped);
+    } else {
+        const perf_stat_t *s = &perf_stats[line - 2];
+        n = snprintf(perf_line, sizeof(perf_line), "@s %s %lu %llu %lu %lu", perf_names[line - 2],
+                     (unsigned long)s->count, (unsigned long long)s->sum_us,
+                     (unsigned long)s->min_us, (unsigned long)s->max_us);
+        for (uint b = 0; b < PERF_HIST_BINS; b++)
+            n += snprintf(perf_line + n, sizeof(perf_line) - n, " %lu", (unsigned long)s->hist[b]);
+        n += snprintf(perf_line + n, sizeof(perf_line) - n, "\n");
+    }
+    return (uint)n < sizeof(perf_line) ? (uint)n : sizeof(perf_line) - 1;
+}
+
+// Envia os acumulados pela saída de log a cada PERF_REPORT_MS, em linhas
+// iniciadas por '@' que host/perf_decode separa do resto da saída:
+//   @b <dois cores> <dithering> <fitas> <LEDs>
+//   @c <t_us> <quadros apresentados> <transmitidos> <eventos do botão> <perdidos>
+//   @s <nome> <n> <soma_us> <min_us> <max_us> <hist 0..PERF_HIST_BINS-1>
+// Chamado a cada tick, nunca espera pela USB: formata no máximo uma linha e
+// entrega até PERF_TICK_BYTES bytes por chamada, só o que cabe agora no
+// buffer de saída (hal_log_write); o resto fica para os ticks seguintes.
+// Os valores são acumulados desde o boot e lidos linha a linha, então um
+// relatório pode misturar medidas de ticks vizinhos.
+void perfPoll(uint64_t now) {
+    static uint64_t next_report = 0;
+    if (perf_line_sent == perf_line_len) {
+        if (perf_next_line == PERF_REPORT_LINES) {
+            if (now < next_report)
+                return;
+            next_report = now + PERF_REPORT_MS * 1000ull;
+            perf_next_line = 0;
+        }
+        perf_line_len = perfFormatLine(perf_next_line++, now);
+        perf_line_sent = 0;
+    }
+
+    uint n = perf_line_len - perf_line_sent;
+    if (n > PERF_TICK_BYTES)
+        n = PERF_TICK_BYTES;
+    perf_line_sent += hal_log_write(perf_line + perf_line_sent, n);
+}
+
+// Termina o relatório em andamento, esperando a saída (fim de simon_bench)
+void perfFlush(uint64_t now) {
+    while (perf_line_sent < perf_line_len || perf_next_line < PERF_REPORT_LINES) {
+        if (perf_line_sent == perf_line_len) {
+            perf_line_len = perfFormatLine(perf_next_line++, now);
+            perf_line_sent = 0;
+        }
+        perf_line_sent += hal_log_write(perf_line + perf_line_sent, perf_line_len - perf_line_sent);
+    }
+}
+
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "hal.h"
+
+// Instrumentação de desempenho. Com SIMON_PERF=0 (opção do CMake) as
+// medidas viram funções vazias e o compilador as remove.
+#ifndef SIMON_PERF
+#define SIMON_PERF 1
+#endif
+
+#define PERF_HIST_BINS 16       // Faixas de potência de 2 em µs: 0, 1, 2-3, 4-7, ...
+#define PERF_REPORT_MS 1000     // Período do envio pela USB
+#define PERF_TICK_BYTES 64      // Máximo entregue à USB por tick
+
+// Trechos medidos. Cada um é escrito por um único core.
+typedef enum {
+    PERF_PRESENT,   // npPresent no renderizador
+    PERF_INPUT,     // Leitura do botão e do joystick em gameUpdate
+    PERF_ANIM_STEP, // Aplicação de um quadro de animação (inclui a sequência)
+    PERF_LOOP,      // Uma volta do laço principal
+    PERF_LATENCY,   // Borda do botão até o quadro correspondente ir para o fio
+    PERF_COUNT
+} perf_id_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t hist[PERF_HIST_BINS];
+} perf_stat_t;
+
+#if SIMON_PERF
+extern perf_stat_t perf_stats[PERF_COUNT];
+
+void perfRecord(perf_id_t id, uint32_t us);
+void perfPoll(uint64_t now);
+void perfFlush(uint64_t now);
+
+static inline uint32_t perfStart(void) {
+    return (uint32_t)hal_time_us();
+}
+
+static inline void perfEnd(perf_id_t id, uint32_t start) {
+    perfRecord(id, (uint32_t)hal_time_us() - start);
+}
+#else
+static inline void perfRecord(perf_id_t id, uint32_t us) {}
+static inline void perfPoll(uint64_t now) {}
+static inline void perfFlush(uint64_t now) {}
+static inline uint32_t perfStart(void) { return 0; }
+static inline void perfEnd(perf_id_t id, uint32_t start) {}
+#endif
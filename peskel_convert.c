@@ -1,91 +1,374 @@
-// Converte um código hexadecimal gerado no site: https://www.piskelapp.com/
-// Para decimal em no padrão RGB.
-// O código gerado será utilizado para exibir imagens na matriz de leds neopixel.
+// Compilador de animações exportadas pelo site https://www.piskelapp.com/
+// (File > Export > C file) para quadros prontos para a matriz de LEDs.
+//
+// Todo o trabalho por pixel é feito aqui, no computador: mapeamento
+// serpentina, ordem dos canais, brilho e correção gamma. O firmware só copia
+// as palavras GRB empacotadas (0xGGRRBB00) para o framebuffer.
+//
+// Uso: peskel_convert [opções] -o saida.h|saida.bin arquivo.c...
+//   -o arquivo   saída: cabeçalho C (.h) ou blob binário (.bin)
+//   -b brilho    brilho 0..255 aplicado na conversão (padrão NP_BRIGHTNESS de panel.h)
+//   -g gamma     expoente da correção gamma (padrão 2.2; 1 desliga)
+//   -c ordem     ordem dos canais no fio (padrão GRB)
+//   -d           codifica cada quadro como diferença do anterior
+//
+// A geometria da matriz e o brilho padrão vêm de panel.h, com os mesmos NP_* do firmware.
+// Cada arquivo de entrada vira um asset com o nome do arquivo (sem extensão).
+// Os quadros são lidos e convertidos um de cada vez.
+//
+// Formato delta: o quadro 0 completo (<nome>_key) e, para os quadros
+// 1..N-1 e depois para o retorno N-1 -> 0, uma lista de trechos alterados:
+// uma palavra (inicio << 16 | tamanho) seguida de tamanho palavras GRB.
+// Uma palavra 0 termina o quadro.
+//
+// Blob binário (little-endian), para cada asset:
+//   uint32 número de quadros, uint32 LEDs por quadro, uint32 flags (1 = delta),
+//   uint32 número de palavras, palavras
+#include <ctype.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-#define MATRIX_ROWS 5
-#define MATRIX_COLS 5
-#define MATRIX_DEPTH 3
-
-// Função para converter valores ARGB (0xAARRGGBB) para RGB
-void convertToRGB(int argb, int rgb[3]) {
-    rgb[0] = argb & 0xFF;          // Blue
-    rgb[2] = (argb >> 16) & 0xFF;  // Red
-    rgb[1] = (argb >> 8) & 0xFF;   // Green
-}
-
-int main() {
-    // Matriz de entrada com os valores ARGB
-    int argb_values[MATRIX_ROWS * MATRIX_COLS] = {
-        0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000, 
-        0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff000000, 0xff000000, 0xff000000, 0xff000000
-        };
-
-    // Matriz 5x5x3 para armazenar os valores RGB
-    int rgb_matrix[MATRIX_ROWS][MATRIX_COLS][MATRIX_DEPTH];
-
-    // Preencher a matriz RGB com a conversão dos valores ARGB
-    for (int i = 0; i < MATRIX_ROWS * MATRIX_COLS; i++) {
-        int rgb[3];
-        convertToRGB(argb_values[i], rgb);
-        
-        int row = i / MATRIX_COLS;    // Cálculo da linha
-        int col = i % MATRIX_COLS;    // Cálculo da coluna
-        
-        // Armazenar os valores RGB na matriz 5x5x3
-        rgb_matrix[row][col][0] = rgb[0];  // Red
-        rgb_matrix[row][col][1] = rgb[1];  // Green
-        rgb_matrix[row][col][2] = rgb[2];  // Blue
-    }
-
-    // Exibir a matriz RGB resultante
-    printf("{\n");
-    for (int i = 0; i < MATRIX_ROWS; i++) {
-        printf("    {");
-        for (int j = 0; j < MATRIX_COLS; j++) {
-            printf("{%d, %d, %d}", rgb_matrix[i][j][0], rgb_matrix[i][j][1], rgb_matrix[i][j][2]);
-            if (j < MATRIX_COLS - 1) {
-                printf(", ");
-            }
+#include "panel.h"
+
+#define MAX_PIXELS (256 * 256)
+#define ASSET_FLAG_DELTA 1u
+
+static int brightness = NP_BRIGHTNESS;
+static double gamma_exp = 2.2;
+static char channel_order[4] = "GRB";
+static bool delta_mode = false;
+static bool binary_out = false;
+
+static uint16_t gamma16[256];
+static uint8_t lut[256];
+
+// Mesma conta de npSetBrightness: gamma em 0..65535 escalado pelo brilho e
+// levado a 0..0xFF00, de forma que o asset saia idêntico a npSetLED
+static void buildLut() {
+    for (int i = 0; i < 256; i++) {
+        gamma16[i] = (uint16_t)lround(pow(i / 255.0, gamma_exp) * 65535);
+        uint32_t v = (uint32_t)gamma16[i] * brightness / 255;
+        lut[i] = (v - (v >> 8)) >> 8;
+    }
+}
+
+// Converte um pixel do Piskel (0xAABBGGRR) para RGB, usando o alfa como
+// intensidade: pixels transparentes ficam apagados
+void convertToRGB(uint32_t abgr, uint8_t rgb[3]) {
+    uint32_t a = abgr >> 24;
+    rgb[0] = (abgr & 0xFF) * a / 255;          // Red
+    rgb[1] = ((abgr >> 8) & 0xFF) * a / 255;   // Green
+    rgb[2] = ((abgr >> 16) & 0xFF) * a / 255;  // Blue
+}
+
+// Empacota na ordem de canais do fio, 24 bits nos bits mais significativos
+static uint32_t packPixel(const uint8_t rgb[3]) {
+    uint32_t word = 0;
+    for (int i = 0; i < 3; i++) {
+        int ch = channel_order[i] == 'R' ? 0 : channel_order[i] == 'G' ? 1 : 2;
+        word |= (uint32_t)lut[rgb[ch]] << (24 - 8 * i);
+    }
+    return word;
+}
+
+// Índice do LED na cadeia para a coluna c e a linha r da imagem (r = 0 em
+// cima). Nas coordenadas do jogo, (0, 0) é o canto inferior direito.
+static int ledIndex(int c, int r) {
+    return panelLedIndex(NP_COLS - 1 - c, NP_ROWS - 1 - r);
+}
+
+// Converte um quadro do Piskel para a matriz; imagens maiores que a matriz
+// são amostradas no centro de cada bloco
+static void convertFrame(const uint32_t *pixels, int width, int height, uint32_t *frame) {
+    for (int r = 0; r < NP_ROWS; r++) {
+        for (int c = 0; c < NP_COLS; c++) {
+            int px = (2 * c + 1) * width / (2 * NP_COLS);
+            int py = (2 * r + 1) * height / (2 * NP_ROWS);
+            uint8_t rgb[3];
+            convertToRGB(pixels[py * width + px], rgb);
+            frame[ledIndex(c, r)] = packPixel(rgb);
+        }
+    }
+}
+
+// Palavras de saída do asset atual
+static uint32_t *words;
+static size_t word_count, word_capacity;
+
+static void emitWord(uint32_t w) {
+    if (word_count == word_capacity) {
+        word_capacity = word_capacity ? word_capacity * 2 : 256;
+        words = realloc(words, word_capacity * sizeof(*words));
+        if (!words) {
+            perror("realloc");
+            exit(1);
         }
-        printf("}");
-        if (i < MATRIX_ROWS - 1) {
-            printf(",");
+    }
+    words[word_count++] = w;
+}
+
+// Trechos de pixels que mudaram de prev para next. Intervalos de um pixel
+// igual são absorvidos no trecho, já que custam o mesmo que um novo cabeçalho.
+static void emitDelta(const uint32_t *prev, const uint32_t *next, int count) {
+    int i = 0;
+    while (i < count) {
+        if (prev[i] == next[i]) {
+            i++;
+            continue;
         }
-        printf("\n");
+        int end = i + 1;
+        while (end < count && (prev[end] != next[end] ||
+                               (end + 1 < count && prev[end + 1] != next[end + 1])))
+            end++;
+        emitWord((uint32_t)i << 16 | (uint32_t)(end - i));
+        for (int j = i; j < end; j++)
+            emitWord(next[j]);
+        i = end;
     }
-    printf("}\n");
+    emitWord(0);
+}
 
-    return 0;
+// Nome do arquivo sem o diretório (separador '/' ou '\\')
+static const char *baseName(const char *path) {
+    const char *base = path;
+    for (const char *p = path; *p; p++) {
+        if (*p == '/' || *p == '\\')
+            base = p + 1;
+    }
+    return base;
+}
+
+// Nome do asset: nome do arquivo sem diretório e extensão, como identificador C
+static void assetName(const char *path, char *name, size_t size) {
+    const char *base = baseName(path);
+    size_t n = 0;
+    if (isdigit((unsigned char)*base))
+        name[n++] = '_';
+    for (; *base && *base != '.' && n + 1 < size; base++)
+        name[n++] = isalnum((unsigned char)*base) ? tolower((unsigned char)*base) : '_';
+    name[n] = '\0';
+}
+
+static void writeHeaderAsset(FILE *out, const char *name, const char *path, int frames,
+                             const uint32_t *key) {
+    char upper[128];
+    int leds = LED_COUNT;
+    for (size_t i = 0; i <= strlen(name); i++)
+        upper[i] = toupper((unsigned char)name[i]);
 
-}
\ No newline at end of file
+    fprintf(out, "\n// %s\n", baseName(path)); // Sem o diretório: a saída não depende da máquina
+    fprintf(out, "#define %s_FRAME_COUNT %d\n", upper, frames);
+    if (delta_mode) {
+        fprintf(out, "static const uint32_t %s_key[%d] = {", name, leds);
+        for (int i = 0; i < leds; i++)
+            fprintf(out, "%s0x%08x,", i % 8 ? " " : "\n    ", key[i]);
+        fprintf(out, "\n};\n");
+        fprintf(out, "static const uint32_t %s_delta[%zu] = {", name, word_count);
+    } else {
+        fprintf(out, "static const uint32_t %s_frames[%d][%d] = {", name, frames, leds);
+    }
+    for (size_t i = 0; i < word_count; i++) {
+        // Quadros completos: um bloco por quadro
+        size_t col = delta_mode ? i : i % leds;
+        if (!delta_mode && col == 0)
+            fprintf(out, "\n    {");
+        fprintf(out, "%s0x%08x,", col % 8 ? " " : delta_mode ? "\n    " : "\n        ", words[i]);
+        if (!delta_mode && col == (size_t)leds - 1)
+            fprintf(out, "\n    },");
+    }
+    fprintf(out, "\n};\n");
+}
+
+static void writeLe32(FILE *out, uint32_t v) {
+    uint8_t b[4] = {v, v >> 8, v >> 16, v >> 24};
+    fwrite(b, 1, 4, out);
+}
+
+static void writeBinaryAsset(FILE *out, int frames, const uint32_t *key) {
+    int leds = LED_COUNT;
+    writeLe32(out, frames);
+    writeLe32(out, leds);
+    writeLe32(out, delta_mode ? ASSET_FLAG_DELTA : 0);
+    writeLe32(out, word_count + (delta_mode ? leds : 0));
+    if (delta_mode) {
+        for (int i = 0; i < leds; i++)
+            writeLe32(out, key[i]);
+    }
+    for (size_t i = 0; i < word_count; i++)
+        writeLe32(out, words[i]);
+}
+
+// Lê um arquivo exportado pelo Piskel e grava o asset correspondente
+static bool convertFile(const char *path, FILE *out) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    // Dimensões vêm dos #define do Piskel; sem eles, a imagem tem o tamanho da matriz
+    int frame_count = 0, width = NP_COLS, height = NP_ROWS;
+    char line[4096];
+    bool in_data = false;
+    while (!in_data && fgets(line, sizeof(line), f)) {
+        char macro[128];
+        int value;
+        if (sscanf(line, " #define %127s %d", macro, &value) == 2) {
+            size_t n = strlen(macro);
+            if (n > 12 && !strcmp(macro + n - 12, "_FRAME_COUNT"))
+                frame_count = value;
+            else if (n > 12 && !strcmp(macro + n - 12, "_FRAME_WIDTH"))
+                width = value;
+            else if (n > 13 && !strcmp(macro + n - 13, "_FRAME_HEIGHT"))
+                height = value;
+        }
+        in_data = strchr(line, '=') != NULL;
+    }
+    if (!in_data || width <= 0 || height <= 0 || width * height > MAX_PIXELS) {
+        fprintf(stderr, "%s: dados do Piskel não encontrados\n", path);
+        fclose(f);
+        return false;
+    }
+
+    int leds = LED_COUNT;
+    uint32_t *pixels = malloc((size_t)width * height * sizeof(uint32_t));
+    uint32_t key[LED_COUNT], prev[LED_COUNT], frame[LED_COUNT];
+    int frames = 0, pixel = 0;
+    word_count = 0;
+
+    // Percorre os literais hexadecimais em ordem, a partir do '=' da
+    // declaração, convertendo cada quadro assim que ele se completa
+    const char *rest = strchr(line, '=') + 1;
+    int ch, last = 0;
+    for (;;) {
+        ch = *rest ? *rest++ : fgetc(f);
+        if (ch == EOF)
+            break;
+        if (!(last == '0' && (ch == 'x' || ch == 'X'))) {
+            last = ch;
+            continue;
+        }
+        uint32_t v = 0;
+        for (;;) {
+            ch = *rest ? *rest++ : fgetc(f);
+            if (ch == EOF || !isxdigit(ch))
+                break;
+            v = v << 4 | (isdigit(ch) ? ch - '0' : (tolower(ch) - 'a' + 10));
+        }
+        last = ch;
+        pixels[pixel++] = v;
+        if (pixel < width * height)
+            continue;
+
+        pixel = 0;
+        convertFrame(pixels, width, height, frame);
+        if (frames == 0) {
+            memcpy(key, frame, leds * sizeof(uint32_t));
+        } else if (delta_mode) {
+            emitDelta(prev, frame, leds);
+        }
+        if (!delta_mode) {
+            for (int i = 0; i < leds; i++)
+                emitWord(frame[i]);
+        }
+        memcpy(prev, frame, leds * sizeof(uint32_t));
+        frames++;
+    }
+    fclose(f);
+    free(pixels);
+
+    if (frames == 0 || pixel != 0 || (frame_count && frames != frame_count)) {
+        fprintf(stderr, "%s: %d quadros completos lidos (esperado %d de %dx%d)\n",
+                path, frames, frame_count, width, height);
+        return false;
+    }
+    if (delta_mode)
+        emitDelta(prev, key, leds); // Volta ao primeiro quadro nas animações em loop
+
+    char name[96];
+    assetName(path, name, sizeof(name));
+    if (binary_out)
+        writeBinaryAsset(out, frames, key);
+    else
+        writeHeaderAsset(out, name, path, frames, key);
+    return true;
+}
+
+static bool parseOrder(const char *s) {
+    if (strlen(s) != 3)
+        return false;
+    for (int i = 0; i < 3; i++) {
+        channel_order[i] = toupper((unsigned char)s[i]);
+        if (!strchr("RGB", channel_order[i]) || strchr(channel_order + i + 1, channel_order[i]))
+            return false;
+    }
+    return strchr(channel_order, 'R') && strchr(channel_order, 'G') && strchr(channel_order, 'B');
+}
+
+static int usage(const char *prog) {
+    fprintf(stderr, "uso: %s [-b brilho] [-g gamma] [-c GRB] [-d] "
+                    "-o saida.h|saida.bin arquivo.c...\n", prog);
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    const char *out_path = NULL;
+    int first_input = argc;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (!strcmp(arg, "-o") && has_value) {
+            out_path = argv[++i];
+        } else if (!strcmp(arg, "-b") && has_value) {
+            brightness = atoi(argv[++i]);
+        } else if (!strcmp(arg, "-g") && has_value) {
+            gamma_exp = atof(argv[++i]);
+        } else if (!strcmp(arg, "-c") && has_value) {
+            if (!parseOrder(argv[++i]))
+                return usage(argv[0]);
+        } else if (!strcmp(arg, "-d")) {
+            delta_mode = true;
+        } else if (arg[0] == '-') {
+            return usage(argv[0]);
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+    if (!out_path || first_input == argc || brightness < 0 || brightness > 255 || gamma_exp <= 0)
+        return usage(argv[0]);
+
+    size_t n = strlen(out_path);
+    binary_out = n > 4 && !strcmp(out_path + n - 4, ".bin");
+    buildLut();
+
+    FILE *out = fopen(out_path, binary_out ? "wb" : "w");
+    if (!out) {
+        perror(out_path);
+        return 1;
+    }
+    if (!binary_out) {
+        fprintf(out, "// Gerado por peskel_convert. Não edite: altere as animações e recompile.\n");
+        fprintf(out, "// Brilho %d, gamma %.2f, ordem %s, matriz %dx%d em %d fita(s)%s\n", brightness, gamma_exp,
+                channel_order, NP_COLS, NP_ROWS, NP_LANES, delta_mode ? ", quadros delta" : "");
+        fprintf(out, "#pragma once\n\n#include <stdint.h>\n\n#include \"panel.h\"\n\n");
+        fprintf(out, "#if NP_PANEL_COLS != %d || NP_PANEL_ROWS != %d || NP_PANELS_X != %d || NP_PANELS_Y != %d\n",
+                NP_PANEL_COLS, NP_PANEL_ROWS, NP_PANELS_X, NP_PANELS_Y);
+        fprintf(out, "#error \"Animações convertidas para outra geometria da matriz\"\n#endif\n");
+    }
+
+    bool ok = true;
+    for (int i = first_input; i < argc && ok; i++)
+        ok = convertFile(argv[i], out);
+    fclose(out);
+    free(words);
+    if (!ok) {
+        remove(out_path);
+        return 1;
+    }
+    return 0;
+}
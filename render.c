@@ -0,0 +1,194 @@
+#include "game.h"
+#include "neopixel.h"
+#include "perf.h"
+#include "render.h"
+
+// Fila de comandos de produtor único (jogo) e consumidor único
+// (renderizador), no mesmo formato da fila do botão.
+#define RENDER_QUEUE_SIZE 16 // Potência de 2
+
+static render_cmd_t render_queue[RENDER_QUEUE_SIZE];
+static volatile uint32_t render_head = 0;
+static volatile uint32_t render_tail = 0;
+static volatile uint32_t render_done_id = 0;  // Última animação concluída
+static uint32_t render_next_id = 0;           // Só o jogo escreve
+
+static bool renderPush(const render_cmd_t *cmd) {
+    uint32_t head = render_head;
+    if (head - render_tail == RENDER_QUEUE_SIZE)
+        return false;
+    render_queue[head % RENDER_QUEUE_SIZE] = *cmd;
+    hal_dmb();
+    render_head = head + 1;
+#if SIMON_DUAL_CORE
+    hal_sev(); // Acorda o core 1 para aplicar o comando sem esperar o tick
+#endif
+    return true;
+}
+
+static bool renderPop(render_cmd_t *cmd) {
+    uint32_t tail = render_tail;
+    if (tail == render_head)
+        return false;
+    hal_dmb();
+    *cmd = render_queue[tail % RENDER_QUEUE_SIZE];
+    hal_dmb();
+    render_tail = tail + 1;
+    return true;
+}
+
+// Envia um comando ao renderizador e retorna o seu id. No modo de um core a
+// fila é esvaziada a cada tick e nunca enche; com dois cores, espera o core 1.
+uint32_t renderSend(const render_cmd_t *cmd) {
+    render_cmd_t queued = *cmd;
+    queued.id = ++render_next_id;
+    while (!renderPush(&queued))
+        tight_loop_contents();
+    return queued.id;
+}
+
+// Id da última animação concluída
+uint32_t renderDoneId() {
+    return render_done_id;
+}
+
+// Há comandos esperando o renderizador
+bool renderHasCommands() {
+    return render_head != render_tail;
+}
+
+// Estado do renderizador: quadro estático atual e animação em andamento
+static render_cmd_t render_frame = {RENDER_CLEAR};
+static anim_player_t render_player;
+static uint32_t render_anim_id = 0;
+static bool render_anim_active = false;
+static uint64_t render_input_us = 0;  // Entrada ainda não vista nos LEDs
+static bool render_dirty = true;      // Quadro precisa ser recomposto
+
+// A exibição da sequência também é uma animação: um quadro apagado de
+// SHOW_LEAD_MS e, por passo, um quadro com o LED aceso e outro apagado.
+// Os quadros são gerados na hora a partir da semente, um trecho de um LED
+// por quadro (cabeçalho, cor e o 0 final), então o tamanho da sequência
+// não tem limite.
+static const uint32_t show_key[LED_COUNT];
+static uint32_t show_seed;
+static uint32_t show_green;
+static uint32_t show_delta[3];
+
+static const uint32_t *showFrame(uint32_t frame, uint16_t *ms) {
+    if (frame == 0) {
+        *ms = SHOW_LEAD_MS;
+        show_delta[0] = 0; // Retorno ao quadro 0: nada muda
+        return show_delta;
+    }
+    *ms = frame % 2 ? SHOW_ON_MS : SHOW_OFF_MS;
+    show_delta[0] = (uint32_t)sequenceStep(show_seed, (frame - 1) / 2) << 16 | 1;
+    show_delta[1] = frame % 2 ? show_green : 0;
+    show_delta[2] = 0;
+    return show_delta;
+}
+
+static anim_sequence_t show_anim = {
+    .key = show_key,
+    .generate = showFrame,
+    .mode = ANIM_ONE_SHOT,
+};
+
+static const anim_sequence_t *startShowAnim(uint32_t seed, uint32_t count) {
+    show_seed = seed;
+    show_green = npColor(0, 255, 0); // LEDs verdes
+    show_anim.frame_count = 1 + 2 * count;
+    return &show_anim;
+}
+
+static void renderStart(const render_cmd_t *cmd, uint64_t now) {
+    render_dirty = true;
+    if (cmd->input_us)
+        render_input_us = cmd->input_us;
+
+    if (cmd->type == RENDER_PLAY_SEQUENCE || cmd->type == RENDER_ANIMATION) {
+        const anim_sequence_t *seq = cmd->type == RENDER_ANIMATION ? cmd->anim : startShowAnim(cmd->seed, cmd->count);
+        animStart(&render_player, seq, (uint16_t)cmd->count, now);
+        render_anim_id = cmd->id;
+        render_anim_active = true;
+    } else {
+        render_frame = *cmd;
+        render_anim_active = false;
+    }
+}
+
+// Avança a animação quando o prazo do quadro vence
+static void renderAdvance(uint64_t now) {
+    bool changed;
+    uint32_t start = perfStart();
+    if (animUpdate(&render_player, now, &changed)) {
+        if (changed)
+            perfEnd(PERF_ANIM_STEP, start);
+        render_dirty |= changed;
+        return;
+    }
+
+    render_anim_active = false;
+    render_dirty = true;
+    render_frame = (render_cmd_t){RENDER_CLEAR};
+    render_done_id = render_anim_id;
+}
+
+// Desenha no back buffer o quadro estático atual. Durante uma animação o
+// back buffer é dela: os quadros são aplicados por animUpdate.
+static void renderCompose() {
+    if (render_anim_active)
+        return;
+    npClear();
+
+    switch (render_frame.type) {
+    case RENDER_CURSOR:
+        npSetLED(render_frame.index, 50, 50, 50); // Indica posição do LED
+        break;
+    case RENDER_LED:
+        npSetLED(render_frame.index, render_frame.color >> 16, render_frame.color >> 8, render_frame.color);
+        break;
+    default:
+        break;
+    }
+}
+
+// Um tick do renderizador: aplica os comandos, avança a animação e, se algo
+// mudou, apresenta o quadro sem bloquear. Se o link estiver ocupado, o
+// quadro é recomposto e enviado no próximo tick.
+void renderTask(uint64_t now) {
+    render_cmd_t cmd;
+    while (renderPop(&cmd))
+        renderStart(&cmd, now);
+
+    if (render_anim_active)
+        renderAdvance(now);
+
+#if NP_DITHER
+    render_dirty = true; // O dithering precisa de um quadro novo a cada tick
+#endif
+    if (!render_dirty)
+        return;
+
+    renderCompose();
+    uint32_t start = perfStart();
+    bool presented = npPresent();
+    perfEnd(PERF_PRESENT, start);
+    if (!presented)
+        return;
+    render_dirty = false;
+
+    // Latência da borda de entrada até o quadro correspondente ir para o fio
+    if (render_input_us) {
+        perfRecord(PERF_LATENCY, hal_time_us() - render_input_us);
+        render_input_us = 0;
+    }
+}
+
+// Inicializa a saída dos LEDs no core que vai renderizar
+void renderInit() {
+    npInit();
+    npClear();
+    npWrite();
+}
+
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "anim.h"
+
+#ifndef SIMON_DUAL_CORE
+#define SIMON_DUAL_CORE 0
+#endif
+
+// Tempos das animações tocadas pelo renderizador
+#define SHOW_LEAD_MS 500        // Matriz apagada antes da sequência
+#define SHOW_ON_MS 500          // Tempo aceso de cada passo da sequência
+#define SHOW_OFF_MS 250         // Intervalo entre passos
+#define FLASH_MS 200            // Meio período de cada piscada vermelha
+
+// Comandos de desenho. O jogo não toca nos LEDs: ele envia comandos ao
+// renderizador, que compõe os quadros, toca as animações e chama npPresent.
+// Com SIMON_DUAL_CORE o renderizador roda no core 1; senão, no mesmo laço.
+typedef enum {
+    RENDER_CLEAR,           // Matriz apagada
+    RENDER_CURSOR,          // Cursor em index
+    RENDER_LED,             // Um LED (index) com a cor color
+    RENDER_PLAY_SEQUENCE,   // Animação: count passos da sequência de seed
+    RENDER_ANIMATION        // Animação anim; ANIM_LOOP toca count voltas
+} render_cmd_type_t;
+
+typedef struct {
+    render_cmd_type_t type;
+    uint16_t index;
+    uint32_t count;
+    uint32_t color;         // 0xRRGGBB
+    uint32_t seed;          // RENDER_PLAY_SEQUENCE: semente da partida
+    const anim_sequence_t *anim; // RENDER_ANIMATION
+    uint32_t id;            // Preenchido por renderSend
+    uint64_t input_us;      // Borda de entrada que originou o comando (0 = nenhuma)
+} render_cmd_t;
+
+uint32_t renderSend(const render_cmd_t *cmd);
+uint32_t renderDoneId();
+bool renderHasCommands();
+void renderInit();
+void renderTask(uint64_t now);
@@ -0,0 +1,93 @@
+#include <string.h>
+
+#include "scores.h"
+
+// Cópias em RAM do recorde e do último registro e a posição de escrita
+static score_record_t score_best, score_last;
+static bool score_has_best = false, score_has_last = false;
+static uint score_sector = 0;   // Setor onde os registros são acrescentados
+static uint score_next = 0;     // Próxima posição livre nesse setor
+static uint32_t score_seq = 0;  // Número do próximo registro
+
+static uint32_t scoreCheck(const score_record_t *r) {
+    return (r->seq ^ (r->seed << 7 | r->seed >> 25) ^ r->score) ^ 0xA5C3E10Fu;
+}
+
+static bool scoreErased(const score_record_t *r) {
+    return (r->seq & r->seed & r->score & r->check) == 0xFFFFFFFFu;
+}
+
+static void scoreTrack(const score_record_t *r) {
+    if (!score_has_last || r->seq >= score_last.seq) {
+        score_last = *r;
+        score_has_last = true;
+    }
+    if (!score_has_best || r->score > score_best.score) {
+        score_best = *r;
+        score_has_best = true;
+    }
+}
+
+// Percorre os dois setores: cada um é usado do início até o primeiro
+// registro apagado. O setor ativo é o do registro mais recente; registros
+// inválidos (gravação interrompida) ocupam a posição mas são ignorados.
+void scoresInit() {
+    const score_record_t *log = (const score_record_t *)hal_store_data();
+    uint used[HAL_STORE_SECTORS] = {0};
+
+    for (uint s = 0; s < HAL_STORE_SECTORS; s++) {
+        for (uint i = 0; i < SCORES_PER_SECTOR; i++) {
+            const score_record_t *r = &log[s * SCORES_PER_SECTOR + i];
+            if (scoreErased(r))
+                break;
+            used[s] = i + 1;
+            if (r->check != scoreCheck(r))
+                continue;
+            if (!score_has_last || r->seq >= score_last.seq)
+                score_sector = s;
+            scoreTrack(r);
+        }
+    }
+    score_next = used[score_sector];
+    score_seq = score_has_last ? score_last.seq + 1 : 0;
+}
+
+// Grava um registro na próxima posição do setor ativo. Só a página que o
+// contém é programada; o resto dela vai como 0xFF e não muda.
+static void scoreWrite(uint32_t seed, uint32_t score) {
+    static uint8_t page[HAL_STORE_PAGE_SIZE];
+    score_record_t r = {score_seq++, seed, score, 0};
+    r.check = scoreCheck(&r);
+
+    uint offset = score_sector * HAL_STORE_SECTOR_SIZE + score_next * sizeof(score_record_t);
+    uint page_offset = offset & ~(HAL_STORE_PAGE_SIZE - 1);
+    memset(page, 0xFF, sizeof(page));
+    memcpy(&page[offset - page_offset], &r, sizeof(r));
+    hal_store_program_page(page_offset, page);
+
+    score_next++;
+    scoreTrack(&r);
+}
+
+// Acrescenta uma partida ao registro. Com o setor ativo cheio, o outro é
+// apagado e recebe primeiro uma cópia do recorde, para que ele nunca se perca.
+void scoresAppend(uint32_t seed, uint32_t score) {
+    if (score_next == SCORES_PER_SECTOR) {
+        score_sector = (score_sector + 1) % HAL_STORE_SECTORS;
+        score_next = 0;
+        hal_store_erase(score_sector);
+        if (score_has_best)
+            scoreWrite(score_best.seed, score_best.score);
+    }
+    scoreWrite(seed, score);
+}
+
+// Maior pontuação registrada, ou NULL se não houver nenhuma
+const score_record_t *scoresBest() {
+    return score_has_best ? &score_best : NULL;
+}
+
+// Partida registrada mais recentemente, ou NULL
+const score_record_t *scoresLast() {
+    return score_has_last ? &score_last : NULL;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "hal.h"
+
+// Registro de partidas na área reservada da flash (hal_store_*): cada fim
+// de jogo acrescenta um registro com a semente e a pontuação, sem apagar
+// nada. Só quando o setor atual enche o outro setor é apagado e recebe o
+// recorde, então cada setor é apagado uma vez a cada SCORES_PER_SECTOR jogos.
+typedef struct {
+    uint32_t seq;       // Número do registro, crescente
+    uint32_t seed;      // Semente da partida (para repeti-la)
+    uint32_t score;     // Rodadas completadas
+    uint32_t check;     // Detecta um registro gravado pela metade
+} score_record_t;
+
+#define SCORES_PER_SECTOR (HAL_STORE_SECTOR_SIZE / sizeof(score_record_t))
+
+void scoresInit();
+void scoresAppend(uint32_t seed, uint32_t score);
+const score_record_t *scoresBest();
+const score_record_t *scoresLast();
@@ -53,5 +53,20 @@ void ws2818b_program_init(PIO pio, uint sm, uint offset, uint pin, float freq) {
   pio_sm_set_enabled(pio, sm, true);
 }
 
+// Variante empacotada: uma palavra GRB (0xGGRRBB00) por LED, bits mais
+// significativos primeiro, com autopull de 24 bits.
+void ws2818b_packed_program_init(PIO pio, uint sm, uint offset, uint pin, float freq) {
+  pio_gpio_init(pio, pin);
+  pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+  pio_sm_config c = ws2818b_program_get_default_config(offset);
+  sm_config_set_sideset_pins(&c, pin); // Uses sideset pins.
+  sm_config_set_out_shift(&c, false, true, 24); // 24 bit transfers, left-shift (MSB first).
+  sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX); // Use only TX FIFO.
+  float prescaler = clock_get_hz(clk_sys) / (10.f * freq); // 10 cycles per transmission, freq is frequency of encoded bits.
+  sm_config_set_clkdiv(&c, prescaler);
+  pio_sm_init(pio, sm, offset, &c);
+  pio_sm_set_enabled(pio, sm, true);
+}
+
 #endif
 